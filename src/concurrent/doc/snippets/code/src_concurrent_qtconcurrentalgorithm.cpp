@@ -0,0 +1,20 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QList<Record> records = ...;
+QFuture<void> sorted = QtConcurrent::sort(records, [](const Record &a, const Record &b) {
+    return a.timestamp < b.timestamp;
+});
+//! [0]
+
+
+//! [1]
+QList<qint64> sizes = ...;
+QtConcurrent::blockingInclusiveScan(sizes);
+// sizes now holds the running totals
+
+auto firstLarge = QtConcurrent::blockingPartition(sizes, [](qint64 total) {
+    return total < 1024 * 1024;
+});
+//! [1]
@@ -0,0 +1,40 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QFile log("access.log");
+log.open(QIODevice::ReadOnly);
+
+QFuture<Summary> summaries = QtConcurrent::pipeline([&log]() -> std::optional<QByteArray> {
+            if (log.atEnd())
+                return std::nullopt;
+            return log.readLine();
+        })
+        .then(parseRequest).withParallelism(4).named("parse")
+        .filter([](const Request &request) { return request.status >= 400; })
+        .then(summarize).inOrder().named("summarize")
+        .withMaxInFlight(64)
+        .start();
+//! [0]
+
+
+//! [1]
+auto images = QtConcurrent::pipeline(fileNames.cbegin(), fileNames.cend())
+        .then([](const QString &fileName) -> std::optional<QImage> {
+            QImage image(fileName);
+            if (image.isNull())
+                return std::nullopt;    // dropped
+            return image;
+        })
+        .then(makeThumbnail).withParallelism(0)
+        .withOrderedResults();
+QFuture<QImage> thumbnails = images.start();
+//! [1]
+
+
+//! [2]
+for (const QtConcurrent::PipelineStageStatistics &stage : images.statistics()) {
+    qDebug() << stage.name << stage.processed << "items," << stage.queued << "waiting,"
+             << stage.busyNSecs / stage.processed << "ns per item";
+}
+//! [2]
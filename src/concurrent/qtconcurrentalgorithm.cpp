@@ -0,0 +1,507 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+  \class QtConcurrent::PhasedKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::SortKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::InclusiveScanKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PartitionKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-1] ThreadEngineStarter<void> QtConcurrent::startSort(QThreadPool *pool, Iterator begin, Iterator end, LessThan &&lessThan, bool stable)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-2] ThreadEngineStarter<void> QtConcurrent::startInclusiveScan(QThreadPool *pool, Iterator begin, Iterator end, BinaryOperation &&operation)
+  \internal
+*/
+
+/*!
+  \fn [qtconcurrentalgorithmkernel-3] ThreadEngineStarter<Iterator> QtConcurrent::startPartition(QThreadPool *pool, Iterator begin, Iterator end, Predicate &&predicate)
+  \internal
+*/
+
+/*!
+    \page qtconcurrentalgorithm.html
+    \title Concurrent Sort, Scan and Partition
+    \ingroup thread
+
+    The QtConcurrent::sort(), QtConcurrent::stableSort(),
+    QtConcurrent::inclusiveScan() and QtConcurrent::partition() functions are
+    parallel versions of std::sort(), std::stable_sort(),
+    std::inclusive_scan() and std::partition(). They work on sequences with
+    random access iterators, such as QList, and modify them in-place.
+
+    These functions are part of the \l {Qt Concurrent} framework.
+
+    Each of them splits the sequence into about as many blocks as the
+    QThreadPool has threads, and processes the blocks in parallel, in one or
+    more rounds. Sequences with only a few thousand items are processed by a
+    single thread, as splitting them costs more than it saves.
+
+    \snippet code/src_concurrent_qtconcurrentalgorithm.cpp 0
+
+    Each function has a blocking variant, which returns once the sequence
+    has been processed:
+
+    \snippet code/src_concurrent_qtconcurrentalgorithm.cpp 1
+
+    Once started, the computation always runs to completion, so that the
+    sequence is never left half processed. Canceling the returned QFuture only
+    keeps more threads from joining in. If the comparison, operation or
+    predicate throws an exception, the exception is reported to the QFuture,
+    and the order of the items in the sequence is unspecified.
+
+    \section1 Sort
+
+    QtConcurrent::sort() and QtConcurrent::stableSort() sort the blocks,
+    and then merge them pairwise until a single sorted run is left. Each
+    merge is again split between the threads. This needs a temporary copy of
+    the sequence, into which the items are moved. The items are compared
+    with \c{operator<()}, unless a comparison function is passed.
+
+    QtConcurrent::stableSort() keeps items that compare equal in their
+    original order.
+
+    \section1 Inclusive Scan
+
+    QtConcurrent::inclusiveScan() replaces each item with the result of
+    combining it with all the items before it, which by default is their
+    sum. The blocks are scanned independently, and then the combination of
+    everything before a block is applied to all of its items, so the
+    operation is called about twice as often as in a sequential scan. The
+    operation must be associative, but does not need to be commutative.
+
+    \section1 Partition
+
+    QtConcurrent::partition() reorders the sequence so that the items for
+    which the predicate returns \c true come before those for which it
+    returns \c false, and returns the iterator to the first item of the
+    second group. The blocks are partitioned independently, and then the
+    items that end up on the wrong side of the final partition point are
+    swapped in parallel. Like std::partition(), this does not keep the
+    relative order of the items.
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. The order of items that compare equal is not
+    preserved. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::sort(Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. The order of items that compare equal is not
+    preserved.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> QFuture<void> QtConcurrent::sort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. The order of items that compare equal is not
+    preserved. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> QFuture<void> QtConcurrent::sort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. The order of items that compare equal is not
+    preserved.
+
+    \sa stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. Items that compare equal keep their relative order.
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> QFuture<void> QtConcurrent::stableSort(Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. Items that compare equal keep their relative order.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> QFuture<void> QtConcurrent::stableSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. Items that compare equal keep their relative
+    order. All work is done by threads taken from the QThreadPool \a pool.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> QFuture<void> QtConcurrent::stableSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. Items that compare equal keep their relative
+    order.
+
+    \sa sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items in \a sequence with the result of combining
+    it with all the items before it, using \a operation, which must be
+    associative. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(Sequence &sequence, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items in \a sequence with the result of combining
+    it with all the items before it, using \a operation, which must be
+    associative.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items from \a begin to \a end with the result of
+    combining it with all the items before it, using \a operation, which
+    must be associative. All work is done by threads taken from the
+    QThreadPool \a pool.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename BinaryOperation> QFuture<void> QtConcurrent::inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items from \a begin to \a end with the result of
+    combining it with all the items before it, using \a operation, which
+    must be associative.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<typename Sequence::iterator> QtConcurrent::partition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items in \a sequence so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. All work is
+    done by threads taken from the QThreadPool \a pool. The result of the
+    returned future is the iterator to the first item of the second group.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> QFuture<typename Sequence::iterator> QtConcurrent::partition(Sequence &sequence, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items in \a sequence so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. The result of
+    the returned future is the iterator to the first item of the second
+    group.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename Predicate> QFuture<RandomAccessIterator> QtConcurrent::partition(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items from \a begin to \a end so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. All work is
+    done by threads taken from the QThreadPool \a pool. The result of the
+    returned future is the iterator to the first item of the second group.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename Predicate> QFuture<RandomAccessIterator> QtConcurrent::partition(RandomAccessIterator begin, RandomAccessIterator end, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items from \a begin to \a end so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. The result of
+    the returned future is the iterator to the first item of the second
+    group.
+
+    \sa {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. The order of items that compare equal is not
+    preserved. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa sort(), stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingSort(Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. The order of items that compare equal is not
+    preserved.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa sort(), stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> void QtConcurrent::blockingSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. The order of items that compare equal is not
+    preserved. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa sort(), stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> void QtConcurrent::blockingSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. The order of items that compare equal is not
+    preserved.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa sort(), stableSort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingStableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. Items that compare equal keep their relative order.
+    All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa stableSort(), sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename LessThan> void QtConcurrent::blockingStableSort(Sequence &sequence, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items in \a sequence in ascending order, using \a lessThan
+    to compare them. Items that compare equal keep their relative order.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa stableSort(), sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> void QtConcurrent::blockingStableSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. Items that compare equal keep their relative
+    order. All work is done by threads taken from the QThreadPool \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa stableSort(), sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename LessThan> void QtConcurrent::blockingStableSort(RandomAccessIterator begin, RandomAccessIterator end, LessThan lessThan)
+    \since 6.6
+
+    Sorts the items from \a begin to \a end in ascending order, using
+    \a lessThan to compare them. Items that compare equal keep their relative
+    order.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa stableSort(), sort(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, Sequence &sequence, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items in \a sequence with the result of combining
+    it with all the items before it, using \a operation, which must be
+    associative. All work is done by threads taken from the QThreadPool
+    \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(Sequence &sequence, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items in \a sequence with the result of combining
+    it with all the items before it, using \a operation, which must be
+    associative.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items from \a begin to \a end with the result of
+    combining it with all the items before it, using \a operation, which
+    must be associative. All work is done by threads taken from the
+    QThreadPool \a pool.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename BinaryOperation> void QtConcurrent::blockingInclusiveScan(RandomAccessIterator begin, RandomAccessIterator end, BinaryOperation operation)
+    \since 6.6
+
+    Replaces each of the items from \a begin to \a end with the result of
+    combining it with all the items before it, using \a operation, which
+    must be associative.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa inclusiveScan(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> typename Sequence::iterator QtConcurrent::blockingPartition(QThreadPool *pool, Sequence &sequence, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items in \a sequence so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. All work is
+    done by threads taken from the QThreadPool \a pool. Returns the
+    iterator to the first item of the second group.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename Sequence, typename Predicate> typename Sequence::iterator QtConcurrent::blockingPartition(Sequence &sequence, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items in \a sequence so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. Returns the
+    iterator to the first item of the second group.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename Predicate> RandomAccessIterator QtConcurrent::blockingPartition(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items from \a begin to \a end so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. All work is
+    done by threads taken from the QThreadPool \a pool. Returns the
+    iterator to the first item of the second group.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
+
+/*!
+    \fn template <typename RandomAccessIterator, typename Predicate> RandomAccessIterator QtConcurrent::blockingPartition(RandomAccessIterator begin, RandomAccessIterator end, Predicate &&predicate)
+    \since 6.6
+
+    Reorders the items from \a begin to \a end so that all items for which
+    \a predicate returns \c true come before those for which it returns
+    \c false. The relative order of the items is not preserved. Returns the
+    iterator to the first item of the second group.
+
+    \note This function will block until the whole range has been processed.
+
+    \sa partition(), {Concurrent Sort, Scan and Partition}
+*/
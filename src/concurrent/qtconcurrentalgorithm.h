@@ -0,0 +1,299 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHM_H
+#define QTCONCURRENT_ALGORITHM_H
+
+#if 0
+#pragma qt_class(QtConcurrentAlgorithm)
+#endif
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentalgorithmkernel.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+// sort() on sequences
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan), false);
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> sort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                     std::move(lessThan), false);
+}
+
+// sort() on iterators
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+QFuture<void> sort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end,
+                   LessThan lessThan = LessThan())
+{
+    return startSort(pool, begin, end, std::move(lessThan), false);
+}
+
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+QFuture<void> sort(RandomAccessIterator begin, RandomAccessIterator end,
+                   LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, std::move(lessThan), false);
+}
+
+// stableSort() on sequences
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> stableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(pool, sequence.begin(), sequence.end(), std::move(lessThan), true);
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+QFuture<void> stableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                     std::move(lessThan), true);
+}
+
+// stableSort() on iterators
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+QFuture<void> stableSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end,
+                         LessThan lessThan = LessThan())
+{
+    return startSort(pool, begin, end, std::move(lessThan), true);
+}
+
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+QFuture<void> stableSort(RandomAccessIterator begin, RandomAccessIterator end,
+                         LessThan lessThan = LessThan())
+{
+    return startSort(QThreadPool::globalInstance(), begin, end, std::move(lessThan), true);
+}
+
+// inclusiveScan() on sequences
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(QThreadPool *pool, Sequence &sequence,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, sequence.begin(), sequence.end(), std::move(operation));
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                              std::move(operation));
+}
+
+// inclusiveScan() on iterators
+template <typename RandomAccessIterator, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(QThreadPool *pool, RandomAccessIterator begin,
+                            RandomAccessIterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(pool, begin, end, std::move(operation));
+}
+
+template <typename RandomAccessIterator, typename BinaryOperation = std::plus<>>
+QFuture<void> inclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                            BinaryOperation operation = BinaryOperation())
+{
+    return startInclusiveScan(QThreadPool::globalInstance(), begin, end, std::move(operation));
+}
+
+// partition() on sequences
+template <typename Sequence, typename Predicate>
+QFuture<typename Sequence::iterator> partition(QThreadPool *pool, Sequence &sequence,
+                                               Predicate &&predicate)
+{
+    return startPartition(pool, sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+template <typename Sequence, typename Predicate>
+QFuture<typename Sequence::iterator> partition(Sequence &sequence, Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                          std::forward<Predicate>(predicate));
+}
+
+// partition() on iterators
+template <typename RandomAccessIterator, typename Predicate>
+QFuture<RandomAccessIterator> partition(QThreadPool *pool, RandomAccessIterator begin,
+                                        RandomAccessIterator end, Predicate &&predicate)
+{
+    return startPartition(pool, begin, end, std::forward<Predicate>(predicate));
+}
+
+template <typename RandomAccessIterator, typename Predicate>
+QFuture<RandomAccessIterator> partition(RandomAccessIterator begin, RandomAccessIterator end,
+                                        Predicate &&predicate)
+{
+    return startPartition(QThreadPool::globalInstance(), begin, end,
+                          std::forward<Predicate>(predicate));
+}
+
+// blockingSort() for sequences
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, sequence.begin(), sequence.end(),
+                                     std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), sequence.begin(),
+                                     sequence.end(), std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+// blockingSort() for iterator ranges
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+void blockingSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end,
+                  LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, begin, end, std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+void blockingSort(RandomAccessIterator begin, RandomAccessIterator end,
+                  LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), begin, end,
+                                     std::move(lessThan), false);
+    future.waitForFinished();
+}
+
+// blockingStableSort() for sequences
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingStableSort(QThreadPool *pool, Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, sequence.begin(), sequence.end(),
+                                     std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename LessThan = std::less<>>
+void blockingStableSort(Sequence &sequence, LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), sequence.begin(),
+                                     sequence.end(), std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+// blockingStableSort() for iterator ranges
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+void blockingStableSort(QThreadPool *pool, RandomAccessIterator begin, RandomAccessIterator end,
+                        LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(pool, begin, end, std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+template <typename RandomAccessIterator, typename LessThan = std::less<>>
+void blockingStableSort(RandomAccessIterator begin, RandomAccessIterator end,
+                        LessThan lessThan = LessThan())
+{
+    QFuture<void> future = startSort(QThreadPool::globalInstance(), begin, end,
+                                     std::move(lessThan), true);
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() for sequences
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(QThreadPool *pool, Sequence &sequence,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, sequence.begin(), sequence.end(),
+                                              std::move(operation));
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(Sequence &sequence, BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), sequence.begin(),
+                                              sequence.end(), std::move(operation));
+    future.waitForFinished();
+}
+
+// blockingInclusiveScan() for iterator ranges
+template <typename RandomAccessIterator, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(QThreadPool *pool, RandomAccessIterator begin,
+                           RandomAccessIterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(pool, begin, end, std::move(operation));
+    future.waitForFinished();
+}
+
+template <typename RandomAccessIterator, typename BinaryOperation = std::plus<>>
+void blockingInclusiveScan(RandomAccessIterator begin, RandomAccessIterator end,
+                           BinaryOperation operation = BinaryOperation())
+{
+    QFuture<void> future = startInclusiveScan(QThreadPool::globalInstance(), begin, end,
+                                              std::move(operation));
+    future.waitForFinished();
+}
+
+// blockingPartition() for sequences
+template <typename Sequence, typename Predicate>
+typename Sequence::iterator blockingPartition(QThreadPool *pool, Sequence &sequence,
+                                              Predicate &&predicate)
+{
+    QFuture<typename Sequence::iterator> future =
+            startPartition(pool, sequence.begin(), sequence.end(),
+                           std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename Sequence, typename Predicate>
+typename Sequence::iterator blockingPartition(Sequence &sequence, Predicate &&predicate)
+{
+    QFuture<typename Sequence::iterator> future =
+            startPartition(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                           std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+// blockingPartition() for iterator ranges
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator blockingPartition(QThreadPool *pool, RandomAccessIterator begin,
+                                       RandomAccessIterator end, Predicate &&predicate)
+{
+    QFuture<RandomAccessIterator> future =
+            startPartition(pool, begin, end, std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+template <typename RandomAccessIterator, typename Predicate>
+RandomAccessIterator blockingPartition(RandomAccessIterator begin, RandomAccessIterator end,
+                                       Predicate &&predicate)
+{
+    QFuture<RandomAccessIterator> future =
+            startPartition(QThreadPool::globalInstance(), begin, end,
+                           std::forward<Predicate>(predicate));
+    return future.takeResult();
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -0,0 +1,555 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_ALGORITHMKERNEL_H
+#define QTCONCURRENT_ALGORITHMKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentthreadengine.h>
+#include <QtCore/qatomic.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+/*
+    The PhasedKernel class runs an algorithm as a sequence of phases. The
+    tasks of a phase run in parallel, and a phase only begins once all tasks
+    of the previous one are done. Threads that find no task left exit; the
+    thread that completes the last task of a phase sets up the next one and
+    starts more threads for it, so no thread ever waits for another.
+*/
+template <typename T>
+class PhasedKernel : public ThreadEngine<T>
+{
+public:
+    explicit PhasedKernel(QThreadPool *pool) : ThreadEngine<T>(pool) { }
+
+protected:
+    // Returns how many tasks \a phase has, or -1 if there are no more
+    // phases. Called by one thread at a time, once all tasks of the
+    // previous phase are done.
+    virtual int taskCount(int phase) = 0;
+    virtual void runTask(int phase, int task) = 0;
+
+    int threadCount() const
+    {
+        return qBound(1, ThreadEngineBase::threadPool->maxThreadCount(), int(MaxTaskCount / 4));
+    }
+
+    void start() override
+    {
+        beginPhase(0);
+    }
+
+    bool shouldStartThread() override
+    {
+        // the threads that are running claim tasks too, once they are done
+        // with their current one
+        const quint64 current = state.loadRelaxed();
+        return nextTask(current) + runningThreads.loadRelaxed() < tasks(current)
+                && !this->shouldThrottleThread();
+    }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        struct RunningThread
+        {
+            QAtomicInt &count;
+            explicit RunningThread(QAtomicInt &count) : count(count) { count.ref(); }
+            ~RunningThread() { count.deref(); }
+        } runningThread(runningThreads);
+
+        for (;;) {
+            // claim a task of the current phase
+            quint64 current = state.loadAcquire();
+            do {
+                if (nextTask(current) >= tasks(current))
+                    return ThreadFinished;
+            } while (!state.testAndSetOrdered(current, current + 1, current));
+
+            if (shouldStartThread())
+                this->startThread();
+
+            const int phase = int(current >> 32);
+            runTask(phase, nextTask(current));
+
+            if (completedTasks.fetchAndAddOrdered(1) + 1 == tasks(current)) {
+                if (!beginPhase(phase + 1))
+                    return ThreadFinished;
+                if (shouldStartThread())
+                    this->startThread();
+            }
+        }
+    }
+
+private:
+    enum : quint64 { MaxTaskCount = 0xffff };
+
+    static int nextTask(quint64 s) { return int(s & MaxTaskCount); }
+    static int tasks(quint64 s) { return int((s >> 16) & MaxTaskCount); }
+
+    bool beginPhase(int phase)
+    {
+        for (;; ++phase) {
+            const int count = taskCount(phase);
+            if (count < 0) {
+                state.storeRelease(quint64(phase) << 32);
+                return false;
+            }
+            if (count > 0) {
+                Q_ASSERT(quint64(count) <= MaxTaskCount);
+                completedTasks.storeRelaxed(0);
+                state.storeRelease((quint64(phase) << 32) | (quint64(count) << 16));
+                return true;
+            }
+        }
+    }
+
+    // phase in the upper 32 bits, then the task count and the next task
+    QAtomicInteger<quint64> state;
+    QAtomicInt completedTasks;
+    QAtomicInt runningThreads;
+};
+
+// Splits \a size items into \a parts parts of about equal size, and returns
+// where part \a part begins.
+inline qsizetype partBegin(qsizetype size, int parts, int part)
+{
+    return qsizetype(qint64(size) * part / parts);
+}
+
+// sort() and stableSort(): sorts blocks into a buffer, then merges pairs of
+// runs back and forth between the buffer and the sequence. Each merge is
+// split into pieces of equal output size, so all threads have work in
+// every round.
+template <typename Iterator, typename LessThan>
+class SortKernel : public PhasedKernel<void>
+{
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "QtConcurrent::sort requires random access iterators");
+
+public:
+    enum { SequentialThreshold = 4096 };
+
+    template <typename F = LessThan>
+    SortKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&lessThan, bool stable)
+        : PhasedKernel<void>(pool),
+          begin(begin),
+          size(std::distance(begin, end)),
+          lessThan(std::forward<F>(lessThan)),
+          stable(stable)
+    { }
+
+    ~SortKernel()
+    {
+        if (!buffer)
+            return;
+        if (!bufferDestroyed) {
+            for (int b = 0; b < blocks; ++b) {
+                if (constructedBlocks[b])
+                    std::destroy(buffer + partBegin(size, blocks, b), buffer + partBegin(size, blocks, b + 1));
+            }
+        }
+        std::allocator<T>().deallocate(buffer, size);
+    }
+
+protected:
+    int taskCount(int phase) override
+    {
+        if (phase == 0) {
+            const int threads = threadCount();
+            if (size < SequentialThreshold || threads == 1)
+                return 1;
+            // an odd number of rounds, so that the result ends up in the sequence
+            rounds = 1;
+            while ((1 << rounds) < threads)
+                rounds += 2;
+            blocks = 1 << rounds;
+            buffer = std::allocator<T>().allocate(size);
+            constructedBlocks.assign(blocks, false);
+            return blocks;
+        }
+        if (!buffer)
+            return -1;
+        if (phase <= rounds) {
+            if (phase & 1)
+                planMerges(phase, buffer);
+            else
+                planMerges(phase, begin);
+            return blocks;
+        }
+        if (phase == rounds + 1) {
+            bufferDestroyed = true;
+            return std::is_trivially_destructible_v<T> ? 0 : blocks;
+        }
+        return -1;
+    }
+
+    void runTask(int phase, int task) override
+    {
+        if (!buffer) {
+            sortRange(begin, begin + size);
+            return;
+        }
+
+        const qsizetype from = partBegin(size, blocks, task);
+        const qsizetype to = partBegin(size, blocks, task + 1);
+        if (phase == 0) {
+            std::uninitialized_move(begin + from, begin + to, buffer + from);
+            constructedBlocks[task] = true;
+            sortRange(buffer + from, buffer + to);
+        } else if (phase <= rounds) {
+            if (phase & 1)
+                mergePiece(phase, task, buffer, begin);
+            else
+                mergePiece(phase, task, begin, buffer);
+        } else {
+            std::destroy(buffer + from, buffer + to);
+        }
+    }
+
+private:
+    template <typename It>
+    void sortRange(It first, It last)
+    {
+        if (stable)
+            std::stable_sort(first, last, lessThan);
+        else
+            std::sort(first, last, lessThan);
+    }
+
+    struct Merge
+    {
+        qsizetype lo;
+        qsizetype mid;
+        qsizetype hi;
+    };
+
+    // In round n, runs of 2^(n-1) blocks are merged, so each block lies
+    // within one merge.
+    Merge mergeOf(int round, int block) const
+    {
+        const int firstBlock = block & ~((1 << round) - 1);
+        return { partBegin(size, blocks, firstBlock),
+                 partBegin(size, blocks, firstBlock + (1 << (round - 1))),
+                 partBegin(size, blocks, firstBlock + (1 << round)) };
+    }
+
+    // Finds where the output of each block starts in the runs that are
+    // merged, before any task starts moving items out of them.
+    template <typename Source>
+    void planMerges(int round, Source source)
+    {
+        splitPoints.resize(blocks);
+        for (int block = 0; block < blocks; ++block) {
+            const Merge merge = mergeOf(round, block);
+            splitPoints[block] = splitPoint(source + merge.lo, merge.mid - merge.lo,
+                                            source + merge.mid, merge.hi - merge.mid,
+                                            partBegin(size, blocks, block) - merge.lo);
+        }
+    }
+
+    // Merges the part of the output of a merge that belongs to \a block.
+    template <typename Source, typename Destination>
+    void mergePiece(int round, int block, Source source, Destination destination)
+    {
+        const Merge merge = mergeOf(round, block);
+        const qsizetype outFrom = partBegin(size, blocks, block) - merge.lo;
+        const qsizetype outTo = partBegin(size, blocks, block + 1) - merge.lo;
+        const qsizetype aFrom = splitPoints[block];
+        const qsizetype aTo = (partBegin(size, blocks, block + 1) == merge.hi)
+                ? merge.mid - merge.lo : splitPoints[block + 1];
+
+        const auto a = source + merge.lo;
+        const auto b = source + merge.mid;
+        std::merge(std::make_move_iterator(a + aFrom), std::make_move_iterator(a + aTo),
+                   std::make_move_iterator(b + (outFrom - aFrom)),
+                   std::make_move_iterator(b + (outTo - aTo)),
+                   destination + merge.lo + outFrom, lessThan);
+    }
+
+    // Returns how many of the first \a count items of the stable merge of
+    // a and b come from a.
+    template <typename It>
+    qsizetype splitPoint(It a, qsizetype aSize, It b, qsizetype bSize, qsizetype count)
+    {
+        qsizetype low = qMax(qsizetype(0), count - bSize);
+        qsizetype high = qMin(count, aSize);
+        while (low < high) {
+            const qsizetype i = low + (high - low) / 2;
+            if (lessThan(b[count - i - 1], a[i]))
+                high = i;
+            else
+                low = i + 1;
+        }
+        return low;
+    }
+
+    const Iterator begin;
+    const qsizetype size;
+    LessThan lessThan;
+    const bool stable;
+    int rounds = 0;
+    int blocks = 0;
+    T *buffer = nullptr;
+    std::vector<char> constructedBlocks; // not bool, as tasks set them concurrently
+    std::vector<qsizetype> splitPoints;
+    bool bufferDestroyed = false;
+};
+
+// inclusiveScan(): scans blocks independently, computes what precedes each
+// block from the last items of the blocks before it, and then adds that to
+// every item of the block.
+template <typename Iterator, typename BinaryOperation>
+class InclusiveScanKernel : public PhasedKernel<void>
+{
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "QtConcurrent::inclusiveScan requires random access iterators");
+
+public:
+    enum { SequentialThreshold = 16384 };
+
+    template <typename F = BinaryOperation>
+    InclusiveScanKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&operation)
+        : PhasedKernel<void>(pool),
+          begin(begin),
+          size(std::distance(begin, end)),
+          operation(std::forward<F>(operation))
+    { }
+
+protected:
+    int taskCount(int phase) override
+    {
+        switch (phase) {
+        case 0:
+            blocks = (size < SequentialThreshold) ? 1 : threadCount();
+            return blocks;
+        case 1:
+            return blocks > 1 ? 1 : -1;
+        case 2:
+            return blocks - 1;
+        default:
+            return -1;
+        }
+    }
+
+    void runTask(int phase, int task) override
+    {
+        switch (phase) {
+        case 0: {
+            const auto from = begin + partBegin(size, blocks, task);
+            const auto to = begin + partBegin(size, blocks, task + 1);
+            std::inclusive_scan(from, to, from, operation);
+            break;
+        }
+        case 1:
+            precedingItems.reserve(blocks - 1);
+            precedingItems.push_back(begin[partBegin(size, blocks, 1) - 1]);
+            for (int b = 2; b < blocks; ++b) {
+                precedingItems.push_back(operation(precedingItems.back(),
+                                                   begin[partBegin(size, blocks, b) - 1]));
+            }
+            break;
+        case 2: {
+            const T &preceding = precedingItems[task];
+            const auto to = begin + partBegin(size, blocks, task + 2);
+            for (auto it = begin + partBegin(size, blocks, task + 1); it != to; ++it)
+                *it = operation(preceding, *it);
+            break;
+        }
+        }
+    }
+
+private:
+    const Iterator begin;
+    const qsizetype size;
+    BinaryOperation operation;
+    int blocks = 0;
+    std::vector<T> precedingItems;
+};
+
+// partition(): partitions blocks independently, then swaps the items that
+// ended up on the wrong side of the final partition point. Those are
+// spread over several ranges, which are treated as one sequence when
+// splitting the swapping into tasks.
+template <typename Iterator, typename Predicate>
+class PartitionKernel : public PhasedKernel<Iterator>
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "QtConcurrent::partition requires random access iterators");
+
+public:
+    enum { SequentialThreshold = 4096 };
+
+    template <typename F = Predicate>
+    PartitionKernel(QThreadPool *pool, Iterator begin, Iterator end, F &&predicate)
+        : PhasedKernel<Iterator>(pool),
+          begin(begin),
+          size(std::distance(begin, end)),
+          predicate(std::forward<F>(predicate)),
+          partitionPoint(begin)
+    { }
+
+    Iterator *result() override { return &partitionPoint; }
+
+protected:
+    int taskCount(int phase) override
+    {
+        switch (phase) {
+        case 0:
+            blocks = (size < SequentialThreshold) ? 1 : this->threadCount();
+            blockEnds.resize(blocks);
+            return blocks;
+        case 1:
+            if (blocks == 1)
+                return -1;
+            planSwaps();
+            return swapCount ? blocks : -1;
+        default:
+            return -1;
+        }
+    }
+
+    void runTask(int phase, int task) override
+    {
+        if (phase == 0) {
+            const auto from = begin + partBegin(size, blocks, task);
+            const auto to = begin + partBegin(size, blocks, task + 1);
+            blockEnds[task] = std::partition(from, to, predicate) - begin;
+            if (blocks == 1)
+                partitionPoint = begin + blockEnds[task];
+            return;
+        }
+
+        qsizetype index = partBegin(swapCount, blocks, task);
+        const qsizetype last = partBegin(swapCount, blocks, task + 1);
+        if (index == last)
+            return;
+        auto left = findRange(leftRanges, index);
+        auto right = findRange(rightRanges, index);
+        while (index < last) {
+            const qsizetype n = std::min({ last - index,
+                                           left->to - (left->from + index - left->offset),
+                                           right->to - (right->from + index - right->offset) });
+            std::swap_ranges(begin + left->from + (index - left->offset),
+                             begin + left->from + (index - left->offset) + n,
+                             begin + right->from + (index - right->offset));
+            index += n;
+            if (index == left->offset + (left->to - left->from))
+                ++left;
+            if (index == right->offset + (right->to - right->from))
+                ++right;
+        }
+    }
+
+private:
+    struct Range
+    {
+        qsizetype from;
+        qsizetype to;
+        qsizetype offset;   // of the first item among all ranges
+    };
+    using Ranges = std::vector<Range>;
+
+    // Collects the ranges of items that don't satisfy the predicate before
+    // the final partition point, and those that do after it; both contain
+    // the same number of items.
+    void planSwaps()
+    {
+        qsizetype point = 0;
+        for (int b = 0; b < blocks; ++b)
+            point += blockEnds[b] - partBegin(size, blocks, b);
+        partitionPoint = begin + point;
+
+        qsizetype leftCount = 0;
+        qsizetype rightCount = 0;
+        for (int b = 0; b < blocks; ++b) {
+            const qsizetype from = partBegin(size, blocks, b);
+            const qsizetype to = partBegin(size, blocks, b + 1);
+            const qsizetype wrongLeftFrom = qMax(blockEnds[b], from);
+            const qsizetype wrongLeftTo = qMin(to, point);
+            if (wrongLeftFrom < wrongLeftTo) {
+                leftRanges.push_back({ wrongLeftFrom, wrongLeftTo, leftCount });
+                leftCount += wrongLeftTo - wrongLeftFrom;
+            }
+            const qsizetype wrongRightFrom = qMax(from, point);
+            const qsizetype wrongRightTo = qMin(blockEnds[b], to);
+            if (wrongRightFrom < wrongRightTo) {
+                rightRanges.push_back({ wrongRightFrom, wrongRightTo, rightCount });
+                rightCount += wrongRightTo - wrongRightFrom;
+            }
+        }
+        Q_ASSERT(leftCount == rightCount);
+        swapCount = leftCount;
+    }
+
+    static typename Ranges::const_iterator findRange(const Ranges &ranges, qsizetype index)
+    {
+        auto it = std::upper_bound(ranges.cbegin(), ranges.cend(), index,
+                                   [](qsizetype i, const Range &r) { return i < r.offset; });
+        return it - 1;
+    }
+
+    const Iterator begin;
+    const qsizetype size;
+    Predicate predicate;
+    Iterator partitionPoint;
+    int blocks = 0;
+    std::vector<qsizetype> blockEnds;
+    Ranges leftRanges;
+    Ranges rightRanges;
+    qsizetype swapCount = 0;
+};
+
+//! [qtconcurrentalgorithmkernel-1]
+template <typename Iterator, typename LessThan>
+inline ThreadEngineStarter<void> startSort(QThreadPool *pool, Iterator begin, Iterator end,
+                                           LessThan &&lessThan, bool stable)
+{
+    return startThreadEngine(new SortKernel<Iterator, std::decay_t<LessThan>>(
+            pool, begin, end, std::forward<LessThan>(lessThan), stable));
+}
+
+//! [qtconcurrentalgorithmkernel-2]
+template <typename Iterator, typename BinaryOperation>
+inline ThreadEngineStarter<void> startInclusiveScan(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, BinaryOperation &&operation)
+{
+    return startThreadEngine(new InclusiveScanKernel<Iterator, std::decay_t<BinaryOperation>>(
+            pool, begin, end, std::forward<BinaryOperation>(operation)));
+}
+
+//! [qtconcurrentalgorithmkernel-3]
+template <typename Iterator, typename Predicate>
+inline ThreadEngineStarter<Iterator> startPartition(QThreadPool *pool, Iterator begin,
+                                                    Iterator end, Predicate &&predicate)
+{
+    return startThreadEngine(new PartitionKernel<Iterator, std::decay_t<Predicate>>(
+            pool, begin, end, std::forward<Predicate>(predicate)));
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
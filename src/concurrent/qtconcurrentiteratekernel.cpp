@@ -33,6 +33,65 @@ namespace QtConcurrent {
   \internal
  */
 
+/*!
+    \class QtConcurrent::SchedulingPolicy
+    \inmodule QtConcurrent
+    \since 6.6
+
+    \brief The SchedulingPolicy class describes how the items of a sequence
+    are handed to the threads of a parallel map.
+
+    The threads processing a sequence reserve a block of consecutive items at
+    a time. Larger blocks make reserving them cheaper compared to processing
+    the items, which matters if the map function is very cheap; smaller
+    blocks spread the work more evenly, which matters if it takes very
+    different time for different items.
+
+    Sequences without random access iterators are always processed one item
+    at a time, regardless of the policy.
+
+    \sa QtConcurrent::map(), QtConcurrent::blockingMap()
+*/
+
+/*!
+    \enum QtConcurrent::SchedulingPolicy::Mode
+
+    \value Adaptive Each thread starts with blocks of the minimum block
+        size, and doubles it while reserving the items takes a noticeable
+        share of the time spent processing them. This is the default.
+    \value Guided Each thread reserves a share of the items that are still
+        left, which is never smaller than the minimum block size. Blocks get
+        smaller towards the end of the sequence, so that the threads finish
+        at about the same time even if some items take much longer than
+        others.
+*/
+
+/*!
+    \fn QtConcurrent::SchedulingPolicy::SchedulingPolicy()
+
+    Constructs an adaptive policy with a minimum block size of 1.
+*/
+
+/*!
+    \fn QtConcurrent::SchedulingPolicy::SchedulingPolicy(Mode mode, int minimumBlockSize)
+
+    Constructs a policy of the given \a mode, which reserves at least
+    \a minimumBlockSize items at a time, except at the end of the sequence.
+    Values smaller than 1 are treated as 1.
+*/
+
+/*!
+    \fn QtConcurrent::SchedulingPolicy::Mode QtConcurrent::SchedulingPolicy::mode() const
+
+    Returns the mode of this policy.
+*/
+
+/*!
+    \fn int QtConcurrent::SchedulingPolicy::minimumBlockSize() const
+
+    Returns the smallest number of items that are reserved at a time.
+*/
+
 /*!
   \class QtConcurrent::BlockSizeManager
   \inmodule QtConcurrent
@@ -67,9 +126,19 @@ namespace QtConcurrent {
 
 */
 BlockSizeManager::BlockSizeManager(QThreadPool *pool, int iterationCount)
-    : maxBlockSize(iterationCount / (pool->maxThreadCount() * 2)),
+    : BlockSizeManager(pool, iterationCount, 1)
+{ }
+
+/*! \internal
+
+    Starts with blocks of \a minimumBlockSize iterations, and never grows
+    them beyond a share of \a iterationCount that still keeps all threads of
+    \a pool busy, unless that is less than \a minimumBlockSize.
+*/
+BlockSizeManager::BlockSizeManager(QThreadPool *pool, int iterationCount, int minimumBlockSize)
+    : maxBlockSize(qMax(iterationCount / (pool->maxThreadCount() * 2), minimumBlockSize)),
       beforeUser(0), afterUser(0),
-      m_blockSize(1)
+      m_blockSize(minimumBlockSize)
 { }
 
 // Records the time before user code.
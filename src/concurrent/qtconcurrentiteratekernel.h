@@ -20,6 +20,27 @@ QT_BEGIN_NAMESPACE
 
 namespace QtConcurrent {
 
+class SchedulingPolicy
+{
+public:
+    enum Mode {
+        Adaptive,
+        Guided
+    };
+
+    constexpr SchedulingPolicy() noexcept = default;
+    constexpr explicit SchedulingPolicy(Mode mode, int minimumBlockSize = 1) noexcept
+        : m_mode(mode), m_minimumBlockSize(minimumBlockSize < 1 ? 1 : minimumBlockSize)
+    { }
+
+    constexpr Mode mode() const noexcept { return m_mode; }
+    constexpr int minimumBlockSize() const noexcept { return m_minimumBlockSize; }
+
+private:
+    Mode m_mode = Adaptive;
+    int m_minimumBlockSize = 1;
+};
+
 /*
     The BlockSizeManager class manages how many iterations a thread should
     reserve and process at a time. This is done by measuring the time spent
@@ -32,6 +53,7 @@ class Q_CONCURRENT_EXPORT BlockSizeManager
 {
 public:
     explicit BlockSizeManager(QThreadPool *pool, int iterationCount);
+    BlockSizeManager(QThreadPool *pool, int iterationCount, int minimumBlockSize);
 
     void timeBeforeUser();
     void timeAfterUser();
@@ -218,18 +240,28 @@ public:
 
     ThreadFunctionResult forThreadFunction()
     {
-        BlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, iterationCount);
+        const int minimumBlockSize = schedulingPolicy.minimumBlockSize();
+        const bool guided = schedulingPolicy.mode() == SchedulingPolicy::Guided;
+        const int threadCount = qMax(ThreadEngineBase::threadPool->maxThreadCount(), 1);
+        BlockSizeManager blockSizeManager(ThreadEngineBase::threadPool, iterationCount,
+                                          minimumBlockSize);
         ResultReporter<T> resultReporter = createResultsReporter();
 
         for(;;) {
             if (this->isCanceled())
                 break;
 
-            const int currentBlockSize = blockSizeManager.blockSize();
-
-            if (currentIndex.loadRelaxed() >= iterationCount)
+            const int nextIndex = currentIndex.loadRelaxed();
+            if (nextIndex >= iterationCount)
                 break;
 
+            // Guided scheduling takes a share of what is left, so that the
+            // blocks get smaller towards the end and all threads finish at
+            // about the same time, without measuring anything.
+            const int currentBlockSize = guided
+                    ? qMax((iterationCount - nextIndex) / (2 * threadCount), minimumBlockSize)
+                    : blockSizeManager.blockSize();
+
             // Atomically reserve a block of iterationCount for this thread.
             const int beginIndex = currentIndex.fetchAndAddRelease(currentBlockSize);
             const int endIndex = qMin(beginIndex + currentBlockSize, iterationCount);
@@ -248,9 +280,11 @@ public:
             resultReporter.reserveSpace(finalBlockSize);
 
             // Call user code with the current iteration range.
-            blockSizeManager.timeBeforeUser();
+            if (!guided)
+                blockSizeManager.timeBeforeUser();
             const bool resultsAvailable = this->runIterations(begin, beginIndex, endIndex, resultReporter.getPointer());
-            blockSizeManager.timeAfterUser();
+            if (!guided)
+                blockSizeManager.timeAfterUser();
 
             if (resultsAvailable)
                 resultReporter.reportResults(beginIndex);
@@ -322,6 +356,7 @@ public:
     const int iterationCount;
     const bool forIteration;
     bool progressReportingEnabled;
+    SchedulingPolicy schedulingPolicy;
     DefaultValueContainer<ResultType> defaultValue;
 };
 
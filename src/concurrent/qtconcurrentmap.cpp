@@ -101,8 +101,15 @@
     \value OrderedReduce Reduction is done in the order of the
     original sequence.
     \value SequentialReduce Reduction is done sequentially: only one
-    thread will enter the reduce function at a time. (Parallel reduction
-    might be supported in a future version of Qt Concurrent.)
+    thread will enter the reduce function at a time.
+    \value [since 6.6] ParallelReduce Reduction is done in parallel: each
+    thread reduces the results it computed into an accumulator of its own,
+    and the accumulators are combined pairwise with the reduce function once
+    all results have been reduced. This requires that the intermediate
+    results are of the result type, and that the result type is
+    default-constructible, as the accumulators start out as
+    default-constructed values. The results are reduced in an arbitrary
+    order. Otherwise, the reduction is done as for UnorderedReduce.
 */
 
 /*!
@@ -303,6 +310,30 @@
     \sa {Concurrent Map and Map-Reduce}
 */
 
+/*!
+    \fn template <typename Sequence, typename MapFunctor> QFuture<void> QtConcurrent::map(QThreadPool *pool, Sequence &&sequence, MapFunctor &&function, QtConcurrent::SchedulingPolicy policy)
+    \since 6.6
+
+    Calls \a function once for each item in \a sequence, handing the items
+    to the threads taken from the QThreadPool \a pool as described by
+    \a policy. The \a function takes a reference to the item, so that any
+    modifications done to the item will appear in \a sequence.
+
+    \sa QtConcurrent::SchedulingPolicy, {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor> QFuture<void> QtConcurrent::map(Sequence &&sequence, MapFunctor &&function, QtConcurrent::SchedulingPolicy policy)
+    \since 6.6
+
+    Calls \a function once for each item in \a sequence, handing the items
+    to the threads as described by \a policy. The \a function takes a
+    reference to the item, so that any modifications done to the item will
+    appear in \a sequence.
+
+    \sa QtConcurrent::SchedulingPolicy, {Concurrent Map and Map-Reduce}
+*/
+
 /*!
     \fn template <typename Iterator, typename MapFunctor> QFuture<void> QtConcurrent::map(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&function)
 
@@ -519,6 +550,34 @@
   \sa map(), {Concurrent Map and Map-Reduce}
 */
 
+/*!
+    \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(QThreadPool *pool, Sequence &&sequence, MapFunctor &&function, QtConcurrent::SchedulingPolicy policy)
+    \since 6.6
+
+    Calls \a function once for each item in \a sequence, handing the items
+    to the threads taken from the QThreadPool \a pool as described by
+    \a policy. The \a function takes a reference to the item, so that any
+    modifications done to the item will appear in \a sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa map(), QtConcurrent::SchedulingPolicy, {Concurrent Map and Map-Reduce}
+*/
+
+/*!
+    \fn template <typename Sequence, typename MapFunctor> void QtConcurrent::blockingMap(Sequence &&sequence, MapFunctor &&function, QtConcurrent::SchedulingPolicy policy)
+    \since 6.6
+
+    Calls \a function once for each item in \a sequence, handing the items
+    to the threads as described by \a policy. The \a function takes a
+    reference to the item, so that any modifications done to the item will
+    appear in \a sequence.
+
+    \note This function will block until all items in the sequence have been processed.
+
+    \sa map(), QtConcurrent::SchedulingPolicy, {Concurrent Map and Map-Reduce}
+*/
+
 /*!
     \fn template <typename Iterator, typename MapFunctor> void QtConcurrent::blockingMap(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&function)
 
@@ -36,6 +36,21 @@ QFuture<void> map(Sequence &&sequence, MapFunctor &&map)
                     std::forward<MapFunctor>(map));
 }
 
+template <typename Sequence, typename MapFunctor>
+QFuture<void> map(QThreadPool *pool, Sequence &&sequence, MapFunctor &&map,
+                  SchedulingPolicy policy)
+{
+    return startMap(pool, sequence.begin(), sequence.end(), std::forward<MapFunctor>(map),
+                    policy);
+}
+
+template <typename Sequence, typename MapFunctor>
+QFuture<void> map(Sequence &&sequence, MapFunctor &&map, SchedulingPolicy policy)
+{
+    return startMap(QThreadPool::globalInstance(), sequence.begin(), sequence.end(),
+                    std::forward<MapFunctor>(map), policy);
+}
+
 // map() on iterators
 template <typename Iterator, typename MapFunctor>
 QFuture<void> map(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&map)
@@ -407,6 +422,23 @@ void blockingMap(Sequence &&sequence, MapFunctor &&map)
     future.waitForFinished();
 }
 
+template <typename Sequence, typename MapFunctor>
+void blockingMap(QThreadPool *pool, Sequence &&sequence, MapFunctor &&map,
+                 SchedulingPolicy policy)
+{
+    QFuture<void> future = startMap(pool, sequence.begin(), sequence.end(),
+                                    std::forward<MapFunctor>(map), policy);
+    future.waitForFinished();
+}
+
+template <typename Sequence, typename MapFunctor>
+void blockingMap(Sequence &&sequence, MapFunctor &&map, SchedulingPolicy policy)
+{
+    QFuture<void> future = startMap(QThreadPool::globalInstance(), sequence.begin(),
+                                    sequence.end(), std::forward<MapFunctor>(map), policy);
+    future.waitForFinished();
+}
+
 // blockingMap() for iterator ranges
 template <typename Iterator, typename MapFunctor>
 void blockingMap(QThreadPool *pool, Iterator begin, Iterator end, MapFunctor &&map)
@@ -180,6 +180,17 @@ inline ThreadEngineStarter<void> startMap(QThreadPool *pool, Iterator begin,
             pool, begin, end, std::forward<Functor>(functor)));
 }
 
+template <typename Iterator, typename Functor>
+inline ThreadEngineStarter<void> startMap(QThreadPool *pool, Iterator begin,
+                                          Iterator end, Functor &&functor,
+                                          SchedulingPolicy policy)
+{
+    auto kernel = new MapKernel<Iterator, std::decay_t<Functor>>(
+            pool, begin, end, std::forward<Functor>(functor));
+    kernel->schedulingPolicy = policy;
+    return startThreadEngine(kernel);
+}
+
 //! [qtconcurrentmapkernel-2]
 template <typename T, typename Iterator, typename Functor>
 inline ThreadEngineStarter<T> startMapped(QThreadPool *pool, Iterator begin,
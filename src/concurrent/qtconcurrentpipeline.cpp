@@ -0,0 +1,285 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+/*!
+  \class QtConcurrent::PipelineKernel
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PipelineSource
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PipelineStage
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+  \class QtConcurrent::PipelineOutput
+  \inmodule QtConcurrent
+  \internal
+*/
+
+/*!
+    \page qtconcurrentpipeline.html
+    \title Concurrent Pipeline
+    \ingroup thread
+
+    QtConcurrent::pipeline() processes a stream of items in a chain of
+    stages, such as reading, parsing, transforming and writing records. Each
+    stage may process several items in parallel, and all stages run at the
+    same time, on the threads of a QThreadPool. Unlike QtConcurrent::mapped(),
+    the items don't need to be in a container first: the source produces them
+    while the pipeline runs, and only a bounded number of them is held in
+    memory at any time.
+
+    This is part of the \l {Qt Concurrent} framework.
+
+    A pipeline is built from a source, and then stages are appended to it
+    with \l {QtConcurrent::Pipeline::then}{then()} and
+    \l {QtConcurrent::Pipeline::filter}{filter()}. The functions following
+    the stage adjust how it runs. Finally,
+    \l {QtConcurrent::Pipeline::start}{start()} returns a QFuture that
+    receives the results of the last stage as they become available:
+
+    \snippet code/src_concurrent_qtconcurrentpipeline.cpp 0
+
+    \section1 Sources and Stages
+
+    The source is a function that returns a \c std::optional with the next
+    item, or \c std::nullopt at the end of the stream, or a pair of
+    iterators. It is always called by one thread at a time.
+
+    A function passed to then() is called with each item, and returns the
+    item passed to the next stage. If it returns a \c std::optional, empty
+    results are dropped. A function passed to filter() returns \c true for
+    the items to keep. The last stage may return \c void, in which case the
+    pipeline returns a QFuture<void>.
+
+    \snippet code/src_concurrent_qtconcurrentpipeline.cpp 1
+
+    \section1 Parallelism and Order
+
+    By default, each stage processes one item at a time. withParallelism()
+    allows a stage to process several items at the same time, which means
+    that its function must be thread-safe. Items may then overtake each
+    other. inOrder() makes a stage process its items one at a time, in the
+    order the source produced them, which is useful for stages that write to
+    a file or a socket. withOrderedResults() makes the QFuture receive its
+    results in that order as well.
+
+    Threads prefer the stages closest to the end of the pipeline, so that
+    items leave it as early as possible. A pipeline uses at most as many
+    threads as can process items at the same time, and at most as many as
+    the thread pool allows.
+
+    \section1 Backpressure
+
+    A pipeline holds at most withMaxInFlight() items at a time, counting
+    all of the items between the source and the QFuture. When that many are
+    in flight, the source is not called again until an item has left the
+    pipeline, so a slow stage throttles the source instead of letting items
+    pile up in front of it. Because the limit is shared by all stages, a
+    stage that keeps its items in order can't block the stages before it
+    while it waits for an item that they still have to process.
+
+    The default limit is twice the number of threads in the pool. Stages
+    that keep their items in order and an ordered result may need a higher
+    limit to keep all threads busy, when some items take much longer to
+    process than others.
+
+    \section1 Statistics
+
+    Pipeline::statistics() returns a QtConcurrent::PipelineStageStatistics
+    for the source and each stage, with the number of items processed and
+    dropped, the time spent in the function of the stage, and the items
+    waiting for it. Comparing these shows which stage limits the throughput
+    of the pipeline, and how much parallelism would help it:
+
+    \snippet code/src_concurrent_qtconcurrentpipeline.cpp 2
+
+    \section1 Cancellation and Exceptions
+
+    Canceling the returned QFuture stops the pipeline once the calls that
+    are running have returned; the items still in it are destroyed.
+    Suspending it makes the threads stop taking items. If the source or a
+    stage throws an exception, the pipeline is canceled and the exception is
+    reported to the QFuture.
+*/
+
+/*!
+    \class QtConcurrent::Pipeline
+    \inmodule QtConcurrent
+    \since 6.6
+    \brief The QtConcurrent::Pipeline class builds a concurrent pipeline.
+
+    Pipeline objects are returned by QtConcurrent::pipeline() and by the
+    functions that append stages. \c T is the type of the items leaving the
+    pipeline so far. Copies of a pipeline refer to the same pipeline, which
+    can be started once.
+
+    The functions returning a reference to the pipeline configure the stage
+    that was appended last, or the pipeline as a whole. They must be called
+    before start().
+
+    \sa {Concurrent Pipeline}
+*/
+
+/*!
+    \fn template <typename T> template <typename Function> auto QtConcurrent::Pipeline<T>::then(Function &&function) const
+
+    Appends a stage that calls \a function with each item, and returns a
+    pipeline for the items it returns. If \a function returns a
+    \c std::optional, the items for which it returns \c std::nullopt are
+    dropped. If it returns \c void, no stages can follow.
+
+    \sa filter()
+*/
+
+/*!
+    \fn template <typename T> template <typename Predicate> QtConcurrent::Pipeline<T> QtConcurrent::Pipeline<T>::filter(Predicate &&predicate) const
+
+    Appends a stage that passes on the items for which \a predicate returns
+    \c true, and drops the others.
+
+    \sa then()
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::withParallelism(int count)
+
+    Allows the last stage to process up to \a count items at the same time.
+    If \a count is 0 or less, it may use all threads of the pool. The source
+    and stages that keep their items in order always process one item at a
+    time.
+
+    \sa inOrder()
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::inOrder()
+
+    Makes the last stage process its items one at a time, in the order in
+    which the source produced them.
+
+    \sa withParallelism(), withOrderedResults()
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::named(const QString &name)
+
+    Sets the \a name reported for the last stage by statistics().
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::withMaxInFlight(int count)
+
+    Limits the number of items in the pipeline to \a count. If \a count is
+    0 or less, which is the default, the limit is twice the number of
+    threads of the pool.
+
+    \sa {Backpressure}
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::withOrderedResults()
+
+    Makes the returned QFuture receive the results in the order in which
+    the source produced the items. By default, results are reported as soon
+    as they are available.
+*/
+
+/*!
+    \fn template <typename T> QtConcurrent::Pipeline<T> &QtConcurrent::Pipeline<T>::onThreadPool(QThreadPool &pool)
+
+    Runs the pipeline on the threads of \a pool, instead of the global
+    thread pool.
+*/
+
+/*!
+    \fn template <typename T> QFuture<T> QtConcurrent::Pipeline<T>::start() const
+
+    Starts the pipeline and returns a QFuture that receives the results of
+    its last stage. A pipeline can only be started once.
+*/
+
+/*!
+    \fn template <typename T> QList<QtConcurrent::PipelineStageStatistics> QtConcurrent::Pipeline<T>::statistics() const
+
+    Returns the statistics of the source, followed by those of each stage.
+    The statistics can be retrieved while the pipeline runs, and after it
+    has finished.
+*/
+
+/*!
+    \class QtConcurrent::PipelineStageStatistics
+    \inmodule QtConcurrent
+    \since 6.6
+    \brief The QtConcurrent::PipelineStageStatistics struct describes the
+    throughput of a stage of a pipeline.
+
+    \sa QtConcurrent::Pipeline::statistics()
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::name
+
+    The name set with Pipeline::named(), or an empty string.
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::processed
+
+    The number of items the function of the stage returned, including those
+    it dropped. For the source, the number of items it produced.
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::dropped
+
+    The number of items the stage dropped.
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::busyNSecs
+
+    The time all threads spent in the function of the stage, in
+    nanoseconds.
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::queued
+
+    The number of items waiting for the stage.
+*/
+
+/*!
+    \variable QtConcurrent::PipelineStageStatistics::active
+
+    The number of items the stage is processing right now.
+*/
+
+/*!
+    \fn template <typename Generator> auto QtConcurrent::pipeline(Generator &&generator)
+    \since 6.6
+
+    Returns a pipeline whose items are produced by calling \a generator
+    until it returns an empty \c std::optional.
+
+    \sa {Concurrent Pipeline}
+*/
+
+/*!
+    \fn template <typename Iterator> auto QtConcurrent::pipeline(Iterator begin, Iterator end)
+    \since 6.6
+
+    Returns a pipeline whose items are copies of those from \a begin to
+    \a end. The range must stay valid while the pipeline runs.
+
+    \sa {Concurrent Pipeline}
+*/
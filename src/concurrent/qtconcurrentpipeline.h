@@ -0,0 +1,173 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_PIPELINE_H
+#define QTCONCURRENT_PIPELINE_H
+
+#if 0
+#pragma qt_class(QtConcurrentPipeline)
+#endif
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined(Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentpipelinekernel.h>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+template <typename T>
+class Pipeline
+{
+    using Item = PipelineItem<T>;
+
+public:
+    template <typename Function>
+    [[nodiscard]] auto then(Function &&function) const
+    {
+        static_assert(!std::is_void_v<T>, "A pipeline can't continue after a stage returning void");
+        using Out = typename PipelineStageResult<T, std::decay_t<Function>, false>::Type;
+        return addStage<Out, std::decay_t<Function>, false>(std::forward<Function>(function));
+    }
+
+    template <typename Predicate>
+    [[nodiscard]] Pipeline<T> filter(Predicate &&predicate) const
+    {
+        static_assert(!std::is_void_v<T>, "A pipeline can't continue after a stage returning void");
+        return addStage<T, std::decay_t<Predicate>, true>(std::forward<Predicate>(predicate));
+    }
+
+    Pipeline &withParallelism(int count)
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::withParallelism", "The pipeline was already started");
+        if (last->index > 0)
+            last->parallelism = count;
+        return *this;
+    }
+
+    Pipeline &inOrder()
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::inOrder", "The pipeline was already started");
+        last->ordered = true;
+        return *this;
+    }
+
+    Pipeline &named(const QString &name)
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::named", "The pipeline was already started");
+        d->statistics[last->index].name = name;
+        return *this;
+    }
+
+    Pipeline &withMaxInFlight(int count)
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::withMaxInFlight", "The pipeline was already started");
+        d->maxInFlight = count;
+        return *this;
+    }
+
+    Pipeline &withOrderedResults()
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::withOrderedResults", "The pipeline was already started");
+        d->orderedResults = true;
+        return *this;
+    }
+
+    Pipeline &onThreadPool(QThreadPool &pool)
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::onThreadPool", "The pipeline was already started");
+        d->pool = &pool;
+        return *this;
+    }
+
+    QFuture<T> start() const
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::start", "The pipeline was already started");
+        d->started = true;
+
+        const int threadCount = qMax(d->pool->maxThreadCount(), 1);
+        for (PipelineStageBase *stage : d->stages) {
+            if (stage->ordered || stage->index == 0)
+                stage->parallelism = 1;
+            else if (stage->parallelism <= 0)
+                stage->parallelism = threadCount;
+        }
+        if (d->maxInFlight <= 0)
+            d->maxInFlight = 2 * threadCount;
+
+        auto output = d->add(std::make_unique<PipelineOutput<T>>(d.get()));
+        *tail = output;
+        return startThreadEngine(new PipelineKernel<T>(d, output)).startAsynchronously();
+    }
+
+    QList<PipelineStageStatistics> statistics() const
+    {
+        const std::lock_guard locker(d->mutex);
+        return d->statistics;
+    }
+
+private:
+    template <typename U>
+    friend class Pipeline;
+    template <typename Generator>
+    friend auto pipeline(Generator &&generator);
+
+    Pipeline(std::shared_ptr<PipelineShared> data, PipelineInput<Item> **next,
+             PipelineStageBase *stage)
+        : d(std::move(data)), tail(next), last(stage)
+    {}
+
+    template <typename Out, typename Function, bool IsFilter, typename F>
+    Pipeline<Out> addStage(F &&function) const
+    {
+        Q_ASSERT_X(!d->started, "Pipeline::then", "The pipeline was already started");
+        using Stage = PipelineStage<T, Out, Function, IsFilter>;
+        auto stage = d->add(std::make_unique<Stage>(d.get(), int(d->stages.size()),
+                                                    Function(std::forward<F>(function))));
+        *tail = stage;
+        return Pipeline<Out>(d, &stage->next, stage);
+    }
+
+    std::shared_ptr<PipelineShared> d;
+    PipelineInput<Item> **tail;
+    PipelineStageBase *last;
+};
+
+template <typename Generator>
+auto pipeline(Generator &&generator)
+{
+    using Result = std::invoke_result_t<std::decay_t<Generator> &>;
+    static_assert(isOptionalV<Result>, "The source of a pipeline must return a std::optional");
+    using T = typename Result::value_type;
+    using Source = PipelineSource<T, std::decay_t<Generator>>;
+
+    auto d = std::make_shared<PipelineShared>();
+    auto source = d->add(std::make_unique<Source>(
+            d.get(), std::decay_t<Generator>(std::forward<Generator>(generator))));
+    return Pipeline<T>(std::move(d), &source->next, source);
+}
+
+template <typename Iterator>
+auto pipeline(Iterator begin, Iterator end)
+{
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    return pipeline([begin, end]() mutable -> std::optional<T> {
+        if (begin == end)
+            return std::nullopt;
+        return *begin++;
+    });
+}
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
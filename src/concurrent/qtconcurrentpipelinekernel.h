@@ -0,0 +1,484 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTCONCURRENT_PIPELINEKERNEL_H
+#define QTCONCURRENT_PIPELINEKERNEL_H
+
+#include <QtConcurrent/qtconcurrent_global.h>
+
+#if !defined(QT_NO_CONCURRENT) || defined (Q_CLANG_QDOC)
+
+#include <QtConcurrent/qtconcurrentthreadengine.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+
+namespace QtConcurrent {
+
+struct PipelineStageStatistics
+{
+    QString name;
+    qint64 processed = 0;
+    qint64 dropped = 0;
+    qint64 busyNSecs = 0;
+    qsizetype queued = 0;
+    int active = 0;
+};
+
+/*
+    A pipeline passes items from a source through a chain of stages to its
+    output. Every item gets a sequence number from the source, so that
+    stages which process items in order, and an ordered output, can restore
+    the order after stages that process items in parallel. Items that are
+    dropped by a filter travel on as empty markers, only to let those stages
+    know that they don't need to wait for them.
+
+    All stages share one mutex, which is only held to move items between
+    them. Memory is bounded by the number of items in flight: the source
+    produces no more items while that many are between it and the output.
+    Unlike a capacity for each buffer, this can't deadlock when a stage or
+    the output waits for an item that is still behind the others.
+*/
+template <typename T>
+using PipelineItem = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+class PipelineNode
+{
+public:
+    virtual ~PipelineNode() = default;
+    // drops all items, once the pipeline has finished
+    virtual void clear() {}
+};
+
+template <typename T>
+class PipelineInput : public PipelineNode
+{
+public:
+    // Hands over item seq, or tells that it was dropped if value is empty.
+    // Called with the mutex held.
+    virtual void deliver(qint64 seq, std::optional<T> &&value) = 0;
+};
+
+struct PipelineShared;
+
+class PipelineStageBase
+{
+public:
+    PipelineStageBase(PipelineShared *sharedData, int stageIndex)
+        : shared(sharedData), index(stageIndex) {}
+    virtual ~PipelineStageBase() = default;
+
+    // how many items could be processed now, if there were enough threads
+    virtual qsizetype readyCount() const = 0;
+    // Processes one item. Called with the mutex held, which is released
+    // while the function of the stage runs.
+    virtual void runOne(std::unique_lock<QMutex> &lock) = 0;
+
+    inline PipelineStageStatistics &statistics();
+
+    PipelineShared *shared;
+    int index;
+    int parallelism = 1;
+    bool ordered = false;
+};
+
+struct PipelineShared
+{
+    QMutex mutex;
+    std::vector<std::unique_ptr<PipelineNode>> nodes;
+    std::vector<PipelineStageBase *> stages;
+    QList<PipelineStageStatistics> statistics;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    int maxInFlight = 0;
+    int inFlight = 0;
+    bool orderedResults = false;
+    bool started = false;
+
+    template <typename Node>
+    Node *add(std::unique_ptr<Node> node)
+    {
+        Node *result = node.get();
+        nodes.push_back(std::move(node));
+        if constexpr (std::is_base_of_v<PipelineStageBase, Node>) {
+            stages.push_back(result);
+            statistics.emplace_back();
+        }
+        return result;
+    }
+};
+
+PipelineStageStatistics &PipelineStageBase::statistics()
+{
+    return shared->statistics[index];
+}
+
+// Measures the time spent in a function of a stage.
+class PipelineStopwatch
+{
+public:
+    PipelineStopwatch() { timer.start(); }
+    void stop(PipelineStageStatistics &statistics) const
+    {
+        statistics.busyNSecs += timer.nsecsElapsed();
+    }
+
+private:
+    QElapsedTimer timer;
+};
+
+template <typename T, typename Generator>
+class PipelineSource : public PipelineStageBase, public PipelineNode
+{
+public:
+    PipelineSource(PipelineShared *sharedData, Generator &&gen)
+        : PipelineStageBase(sharedData, 0), generator(std::move(gen)) {}
+
+    qsizetype readyCount() const override
+    {
+        return !exhausted && shared->inFlight < shared->maxInFlight ? 1 : 0;
+    }
+
+    void runOne(std::unique_lock<QMutex> &lock) override
+    {
+        // claim a place for the item before producing it
+        ++shared->inFlight;
+        ++statistics().active;
+        lock.unlock();
+        const PipelineStopwatch stopwatch;
+        std::optional<T> value = std::invoke(generator);
+        lock.lock();
+        stopwatch.stop(statistics());
+        --statistics().active;
+        if (!value) {
+            exhausted = true;
+            --shared->inFlight;
+            return;
+        }
+        ++statistics().processed;
+        next->deliver(nextSeq++, std::move(value));
+    }
+
+    PipelineInput<T> *next = nullptr;
+
+private:
+    Generator generator;
+    qint64 nextSeq = 0;
+    bool exhausted = false;
+};
+
+template <typename T>
+struct PipelineUnwrapOptional
+{
+    using Type = T;
+};
+
+template <typename T>
+struct PipelineUnwrapOptional<std::optional<T>>
+{
+    using Type = T;
+};
+
+template <typename T>
+inline constexpr bool isOptionalV = false;
+
+template <typename T>
+inline constexpr bool isOptionalV<std::optional<T>> = true;
+
+// The type of the items a stage with function Function passes on: the
+// result without std::optional, or void.
+template <typename In, typename Function, bool IsFilter>
+struct PipelineStageResult
+{
+    using Type = typename PipelineUnwrapOptional<std::invoke_result_t<Function, In &&>>::Type;
+};
+
+template <typename In, typename Function>
+struct PipelineStageResult<In, Function, true>
+{
+    using Type = In;
+};
+
+template <typename In, typename Out, typename Function, bool IsFilter>
+class PipelineStage : public PipelineStageBase, public PipelineInput<In>
+{
+    using OutItem = PipelineItem<Out>;
+
+public:
+    PipelineStage(PipelineShared *sharedData, int stageIndex, Function &&func)
+        : PipelineStageBase(sharedData, stageIndex), function(std::move(func)) {}
+
+    void deliver(qint64 seq, std::optional<In> &&value) override
+    {
+        if (!ordered) {
+            if (value)
+                queue.emplace_back(seq, std::move(*value));
+            else
+                next->deliver(seq, std::nullopt);
+        } else {
+            pending.emplace(seq, std::move(value));
+            forwardDropped();
+        }
+        statistics().queued = qsizetype(queue.size() + pending.size());
+    }
+
+    qsizetype readyCount() const override
+    {
+        if (ordered)
+            return !pending.empty() && pending.begin()->first == nextSeq ? 1 : 0;
+        return qsizetype(queue.size());
+    }
+
+    void runOne(std::unique_lock<QMutex> &lock) override
+    {
+        qint64 seq;
+        std::optional<In> item;
+        if (ordered) {
+            auto it = pending.begin();
+            seq = it->first;
+            item = std::move(it->second);
+            pending.erase(it);
+        } else {
+            seq = queue.front().first;
+            item.emplace(std::move(queue.front().second));
+            queue.pop_front();
+        }
+        statistics().queued = qsizetype(queue.size() + pending.size());
+        ++statistics().active;
+
+        lock.unlock();
+        const PipelineStopwatch stopwatch;
+        std::optional<OutItem> result = invoke(std::move(*item));
+        item.reset();
+        lock.lock();
+
+        PipelineStageStatistics &s = statistics();
+        stopwatch.stop(s);
+        --s.active;
+        ++s.processed;
+        if (!result)
+            ++s.dropped;
+        next->deliver(seq, std::move(result));
+        if (ordered) {
+            ++nextSeq;
+            forwardDropped();
+        }
+    }
+
+    void clear() override
+    {
+        queue.clear();
+        pending.clear();
+    }
+
+    PipelineInput<OutItem> *next = nullptr;
+
+private:
+    std::optional<OutItem> invoke(In &&value)
+    {
+        if constexpr (IsFilter) {
+            if (std::invoke(function, std::as_const(value)))
+                return std::optional<OutItem>(std::move(value));
+            return std::nullopt;
+        } else {
+            using Result = std::invoke_result_t<Function, In &&>;
+            if constexpr (std::is_void_v<Result>) {
+                std::invoke(function, std::move(value));
+                return OutItem();
+            } else {
+                return std::invoke(function, std::move(value));
+            }
+        }
+    }
+
+    // ordered stages pass on the markers of dropped items once it's their turn
+    void forwardDropped()
+    {
+        for (auto it = pending.begin(); it != pending.end() && it->first == nextSeq && !it->second;
+             it = pending.begin()) {
+            pending.erase(it);
+            next->deliver(nextSeq++, std::nullopt);
+        }
+    }
+
+    Function function;
+    std::deque<std::pair<qint64, In>> queue;
+    std::map<qint64, std::optional<In>> pending;
+    qint64 nextSeq = 0;
+};
+
+template <typename T>
+class PipelineOutput : public PipelineInput<PipelineItem<T>>
+{
+    using Item = PipelineItem<T>;
+
+public:
+    explicit PipelineOutput(PipelineShared *sharedData) : shared(sharedData) {}
+
+    void deliver(qint64 seq, std::optional<Item> &&value) override
+    {
+        if (!shared->orderedResults) {
+            report(std::move(value));
+            return;
+        }
+        pending.emplace(seq, std::move(value));
+        for (auto it = pending.begin(); it != pending.end() && it->first == nextSeq;
+             it = pending.begin()) {
+            report(std::move(it->second));
+            pending.erase(it);
+            ++nextSeq;
+        }
+    }
+
+    void clear() override { pending.clear(); }
+
+    QFutureInterface<T> *futureInterface = nullptr;
+
+private:
+    void report(std::optional<Item> &&value)
+    {
+        if constexpr (!std::is_void_v<T>) {
+            if (value)
+                futureInterface->reportAndMoveResult(std::move(*value));
+        }
+        --shared->inFlight;
+    }
+
+    PipelineShared *shared;
+    std::map<qint64, std::optional<Item>> pending;
+    qint64 nextSeq = 0;
+};
+
+template <typename T>
+class PipelineKernel : public ThreadEngine<T>
+{
+public:
+    PipelineKernel(std::shared_ptr<PipelineShared> sharedData, PipelineOutput<T> *out)
+        : ThreadEngine<T>(sharedData->pool), shared(std::move(sharedData)), output(out)
+    {}
+
+    void start() override
+    {
+        output->futureInterface = this->futureInterfaceTyped();
+        starting = 1;
+    }
+
+    void finish() override
+    {
+        // canceled, or an exception was thrown: drop what's left
+        const std::lock_guard locker(shared->mutex);
+        for (auto &node : shared->nodes)
+            node->clear();
+        for (PipelineStageStatistics &s : shared->statistics) {
+            s.queued = 0;
+            s.active = 0;
+        }
+        shared->inFlight = 0;
+    }
+
+    // Threads are started one at a time, from threadFunction(), when there
+    // is more work that can run concurrently than idle threads.
+    bool shouldStartThread() override { return false; }
+
+    ThreadFunctionResult threadFunction() override
+    {
+        this->waitForResume();
+        std::unique_lock lock(shared->mutex);
+        if (starting > 0)
+            --starting;
+        ++threads;
+        while (!this->isCanceled()) {
+            if (this->shouldThrottleThread()) {
+                --threads;
+                return ThrottleThread;
+            }
+            PipelineStageBase *stage = nextStage();
+            if (!stage)
+                break;
+            ++busy;
+            ++active[stage->index];
+#ifndef QT_NO_EXCEPTIONS
+            try {
+#endif
+                stage->runOne(lock);
+#ifndef QT_NO_EXCEPTIONS
+            } catch (...) {
+                if (!lock.owns_lock())
+                    lock.lock();
+                // Reported here rather than by ThreadEngineBase, as the
+                // results are discarded, which must not race with other
+                // threads reporting results.
+                this->futureInterfaceTyped()->reportException(std::current_exception());
+                --active[stage->index];
+                --busy;
+                break;
+            }
+#endif
+            --active[stage->index];
+            --busy;
+            if (needsThread()) {
+                ++starting;
+                lock.unlock();
+                this->startThread();
+                lock.lock();
+            }
+        }
+        --threads;
+        return ThreadFinished;
+    }
+
+private:
+    // Prefers the stages closer to the output, so that items leave the
+    // pipeline as soon as possible.
+    PipelineStageBase *nextStage() const
+    {
+        for (auto it = shared->stages.crbegin(); it != shared->stages.crend(); ++it) {
+            PipelineStageBase *stage = *it;
+            if (active[stage->index] < stage->parallelism && stage->readyCount() > 0)
+                return stage;
+        }
+        return nullptr;
+    }
+
+    // true if there's more work that could run now than idle threads, and
+    // the pool has a thread for it
+    bool needsThread() const
+    {
+        qsizetype ready = 0;
+        for (PipelineStageBase *stage : shared->stages)
+            ready += qMin(stage->readyCount(), qsizetype(stage->parallelism - active[stage->index]));
+        if (ready <= threads + starting - busy)
+            return false;
+        return this->threadPool->activeThreadCount() < this->threadPool->maxThreadCount();
+    }
+
+    std::shared_ptr<PipelineShared> shared;
+    PipelineOutput<T> *output;
+    std::vector<int> active = std::vector<int>(shared->stages.size());
+    int threads = 0;
+    int starting = 0;
+    int busy = 0;
+};
+
+} // namespace QtConcurrent
+
+
+QT_END_NAMESPACE
+
+#endif // QT_NO_CONCURRENT
+
+#endif
@@ -15,7 +15,11 @@
 #include <QtCore/qthread.h>
 #include <QtCore/qthreadpool.h>
 
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,8 +70,8 @@ public:
 enum ReduceOption {
     UnorderedReduce = 0x1,
     OrderedReduce = 0x2,
-    SequentialReduce = 0x4
-    // ParallelReduce = 0x8
+    SequentialReduce = 0x4,
+    ParallelReduce = 0x8
 };
 Q_DECLARE_FLAGS(ReduceOptions, ReduceOption)
 #ifndef Q_CLANG_QDOC
@@ -86,6 +90,16 @@ class ReduceKernel
     const int threadCount;
     ResultsMap resultsMap;
 
+    // ParallelReduce combines the accumulators with the reduce functor, so
+    // the intermediate results must be of the result type. Checking whether
+    // the functor could combine results of another type would instantiate
+    // generic lambdas even when ParallelReduce isn't used.
+    static constexpr bool canReduceInParallel =
+            std::is_default_constructible_v<ReduceResultType>
+            && std::is_same_v<std::decay_t<T>, ReduceResultType>;
+    // the accumulators that are not in use by a thread right now
+    std::vector<std::unique_ptr<ReduceResultType>> accumulators;
+
     bool canReduce(int begin) const
     {
         return (((reduceOptions & UnorderedReduce)
@@ -124,6 +138,13 @@ public:
                    ReduceResultType &r,
                    const IntermediateResults<T> &result)
     {
+        if constexpr (canReduceInParallel) {
+            if (reduceOptions & ParallelReduce) {
+                runParallelReduce(reduce, result);
+                return;
+            }
+        }
+
         std::unique_lock<QMutex> locker(mutex);
         if (!canReduce(result.begin)) {
             ++resultsMapSize;
@@ -179,9 +200,42 @@ public:
         }
     }
 
+    // ParallelReduce: reduces into an accumulator that no other thread uses
+    // at the same time, taking the lock only to pick one
+    void runParallelReduce(ReduceFunctor &reduce, const IntermediateResults<T> &result)
+    {
+        std::unique_ptr<ReduceResultType> accumulator;
+        {
+            std::lock_guard<QMutex> locker(mutex);
+            if (!accumulators.empty()) {
+                accumulator = std::move(accumulators.back());
+                accumulators.pop_back();
+            }
+        }
+        if (!accumulator)
+            accumulator = std::make_unique<ReduceResultType>();
+
+        reduceResult(reduce, *accumulator, result);
+
+        std::lock_guard<QMutex> locker(mutex);
+        accumulators.push_back(std::move(accumulator));
+    }
+
     // final reduction
     void finish(ReduceFunctor &reduce, ReduceResultType &r)
     {
+        if constexpr (canReduceInParallel) {
+            // combine the accumulators pairwise, so that both operands of a
+            // combination tend to be of similar size
+            const size_t count = accumulators.size();
+            for (size_t step = 1; step < count; step *= 2) {
+                for (size_t i = 0; i + step < count; i += 2 * step)
+                    std::invoke(reduce, *accumulators[i], std::as_const(*accumulators[i + step]));
+            }
+            if (count)
+                std::invoke(reduce, r, std::as_const(*accumulators.front()));
+            accumulators.clear();
+        }
         reduceResults(reduce, r, resultsMap);
     }
 
@@ -195,6 +195,25 @@ int main(void)
 }"
 )
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev = {};
+ev.events = EPOLLIN;
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # eventfd
 qt_config_compile_test(eventfd
     LABEL "eventfd"
@@ -566,6 +585,10 @@ qt_feature("dladdr" PRIVATE
     LABEL "dladdr"
     CONDITION QT_FEATURE_dlopen AND TEST_dladdr
 )
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    CONDITION NOT WASM AND TEST_epoll
+)
 qt_feature("eventfd" PUBLIC
     LABEL "eventfd"
     CONDITION NOT WASM AND TEST_eventfd
@@ -339,3 +339,13 @@ for (auto [key, value] : hash.asKeyValueRange()) {
     --value; // convert to JS month indexing
 }
 //! [35]
+
+//! [36]
+QHash<QString, int> counts;
+for (QStringView word : text.tokenize(u' ')) {
+    // no QString is created for the words that are already in the hash
+    ++counts[word];
+}
+if (counts.contains("the"_L1))
+    ...
+//! [36]
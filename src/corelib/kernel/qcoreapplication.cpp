@@ -29,6 +29,7 @@
 #include <QtCore/qpromise.h>
 #endif
 #include <private/qthread_p.h>
+#include <private/qeventdispatchstatistics_p.h>
 #if QT_CONFIG(thread)
 #include <qthreadpool.h>
 #endif
@@ -317,7 +318,10 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 
 qsizetype qGlobalPostedEventsCount()
 {
-    const QPostEventList &l = QThreadData::current()->postEventList;
+    QThreadData *data = QThreadData::current();
+    const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->takePendingPostedEvents();
+    const QPostEventList &l = data->postEventList;
     return l.size() - l.startOffset;
 }
 
@@ -465,6 +469,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->takePendingPostedEvents();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -831,6 +836,9 @@ void QCoreApplicationPrivate::init()
 #endif
 
 #ifndef QT_NO_QOBJECT
+    if (qEnvironmentVariableIsSet("QT_EVENT_DISPATCH_STATISTICS"))
+        QEventDispatchStatistics::setEnabled(true);
+
     is_app_running = true; // No longer starting up.
 #endif
 }
@@ -846,6 +854,9 @@ QCoreApplication::~QCoreApplication()
 
     self = nullptr;
 #ifndef QT_NO_QOBJECT
+    if (QEventDispatchStatistics::isEnabled() && qEnvironmentVariableIsSet("QT_EVENT_DISPATCH_STATISTICS"))
+        QEventDispatchStatistics::dump();
+
     QCoreApplicationPrivate::is_app_closing = true;
     QCoreApplicationPrivate::is_app_running = false;
 #endif
@@ -1021,6 +1032,19 @@ bool QCoreApplication::notifyInternal2(QObject *receiver, QEvent *event)
     QObjectPrivate *d = receiver->d_func();
     QThreadData *threadData = d->threadData.loadAcquire();
     QScopedScopeLevelCounter scopeLevelCounter(threadData);
+    if (Q_UNLIKELY(QEventDispatchStatistics::isEnabled())) {
+        // the receiver may not survive the delivery
+        const QMetaObject *receiverClass = receiver->metaObject();
+        const QEvent::Type type = event->type();
+        const qint64 start = QEventDispatchStatistics::timestamp();
+        const auto recorder = qScopeGuard([&] {
+            QEventDispatchStatistics::recordDispatch(receiverClass, type,
+                                                     QEventDispatchStatistics::timestamp() - start);
+        });
+        if (!selfRequired)
+            return doNotify(receiver, event);
+        return self->notify(receiver, event);
+    }
     if (!selfRequired)
         return doNotify(receiver, event);
     return self->notify(receiver, event);
@@ -1528,6 +1552,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued calls are never compressed and are by far the most common
+    // events posted from other threads, so they don't need to contend for
+    // the receiving thread's mutex.
+    if (event->type() == QEvent::MetaCall && priority == Qt::NormalEventPriority) {
+        QCoreApplicationPrivate::postPendingEvent(receiver, event);
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1537,6 +1569,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QThreadData *data = locker.threadData;
 
+    // keep the events posted without the mutex in order with this one
+    data->takePendingPostedEvents();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1573,7 +1608,10 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     // properly owned in the postEventList
     std::unique_ptr<QEvent> eventDeleter(event);
     Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
-    data->postEventList.addEvent(QPostEvent(receiver, event, priority));
+    QPostEvent pe(receiver, event, priority);
+    if (Q_UNLIKELY(QEventDispatchStatistics::isEnabled()))
+        pe.postedAt = QEventDispatchStatistics::timestamp();
+    data->postEventList.addEvent(pe);
     Q_UNUSED(eventDeleter.release());
     event->m_posted = true;
     ++receiver->d_func()->postedEvents;
@@ -1585,6 +1623,51 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+  \internal
+  Posts \a event with Qt::NormalEventPriority without locking the event list
+  of \a receiver's thread. The event is pushed onto the list's stack of
+  pending events, which is merged into the list the next time it is locked.
+
+  Must only be used for events that are never compressed.
+*/
+void QCoreApplicationPrivate::postPendingEvent(QObject *receiver, QEvent *event)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+
+    // synchronizes with the storeRelease in QObject::moveToThread
+    QThreadData *data = threadData.loadAcquire();
+    if (!data) {
+        // posting during destruction? just delete the event to prevent a leak
+        delete event;
+        return;
+    }
+
+    // delete the event on exceptions to protect against memory leaks till the event is
+    // properly owned in the postEventList
+    std::unique_ptr<QEvent> eventDeleter(event);
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    auto pending = new QPostEventList::PendingEvent{ QPostEvent(receiver, event, Qt::NormalEventPriority), nullptr };
+    if (Q_UNLIKELY(QEventDispatchStatistics::isEnabled()))
+        pending->event.postedAt = QEventDispatchStatistics::timestamp();
+    Q_UNUSED(eventDeleter.release());
+    event->m_posted = true;
+    ++receiver->d_func()->postedEvents;
+    data->postEventList.pushPendingEvent(pending);
+
+    if (Q_UNLIKELY(threadData.loadAcquire() != data)) {
+        // the receiver was moved to another thread while we were posting;
+        // make sure the event follows it
+        const auto locker = qt_scoped_lock(data->postEventList.mutex);
+        data->takePendingPostedEvents();
+        return;
+    }
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1680,6 +1763,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->takePendingPostedEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1787,6 +1871,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
         pe.event->m_posted = false;
         QEvent *e = pe.event;
         QObject * r = pe.receiver;
+        const qint64 postedAt = pe.postedAt;
 
         --r->d_func()->postedEvents;
         Q_ASSERT(r->d_func()->postedEvents >= 0);
@@ -1800,6 +1885,11 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
 
         QScopedPointer<QEvent> event_deleter(e); // will delete the event (with the mutex unlocked)
 
+        if (Q_UNLIKELY(postedAt) && QEventDispatchStatistics::isEnabled()) {
+            QEventDispatchStatistics::recordQueueWait(r->metaObject(), e->type(),
+                                                      QEventDispatchStatistics::timestamp() - postedAt);
+        }
+
         // after all that work, it's time to deliver the event.
         QCoreApplication::sendEvent(r, e);
 
@@ -1842,6 +1932,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
     if (receiver && !receiver->d_func()->postedEvents)
         return;
 
+    data->takePendingPostedEvents();
+
     //we will collect all the posted events for the QObject
     //and we'll delete after the mutex was unlocked
     QVarLengthArray<QEvent*> events;
@@ -1897,6 +1989,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->takePendingPostedEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -118,6 +118,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void postPendingEvent(QObject *receiver, QEvent *event);
 #endif // QT_NO_QOBJECT
 
     int &argc;
@@ -15,11 +15,14 @@
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
 #include <private/qcore_unix_p.h>
+#include <private/qsocketnotifier_p.h>
 
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <iterator>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
@@ -191,14 +194,76 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIsEmpty("QT_NO_EPOLL"))
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
     // cleanup timers
     qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
 }
 
+#if QT_CONFIG(epoll)
+// poll(2) and epoll(7) share the values of the event bits we care about
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI);
+static_assert(EPOLLERR == POLLERR && EPOLLHUP == POLLHUP);
+
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        // fall back to rebuilding the pollfd list on every iteration
+        perror("QEventDispatcherUNIXPrivate: Unable to create epoll instance");
+        return false;
+    }
+    return true;
+}
+
+// The events to watch a descriptor for in the epoll set. A descriptor is
+// only watched edge-triggered if all of its notifiers asked for that.
+static uint epollEvents(const QSocketNotifierSetUNIX &sn_set)
+{
+    uint events = uint(ushort(sn_set.events()));
+    if (!events)
+        return 0;
+    for (const QSocketNotifier *notifier : sn_set.notifiers) {
+        if (notifier && !QSocketNotifierPrivate::get(notifier)->edgeTriggered)
+            return events;
+    }
+    return events | EPOLLET;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, uint oldEvents, uint newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+    epoll_event ev = {};
+    ev.events = newEvents;
+    ev.data.fd = fd;
+
+    int op = !newEvents ? EPOLL_CTL_DEL : (oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD);
+    int ret = epoll_ctl(epollFd, op, fd, &ev);
+    if (ret == -1 && op != EPOLL_CTL_DEL) {
+        // The socket may have been closed and its descriptor reused behind our
+        // back, which also drops the stale registration from the epoll set.
+        if (op == EPOLL_CTL_MOD && errno == ENOENT)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        else if (op == EPOLL_CTL_ADD && errno == EEXIST)
+            ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+        if (ret == -1)
+            qErrnoWarning("QEventDispatcherUNIX: Unable to watch socket %d", fd);
+    }
+}
+#endif
+
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -216,42 +281,67 @@ int QEventDispatcherUNIXPrivate::activateTimers()
 
 void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0) {
+        // only the epoll fd itself was polled; fetch what is actually ready
+        if (!pollfds.isEmpty() && pollfds.constFirst().revents) {
+            epoll_event events[256];
+            int n;
+            EINTR_LOOP(n, epoll_wait(epollFd, events, int(std::size(events)), 0));
+            for (int i = 0; i < n; ++i)
+                markPendingSocketNotifiers(events[i].data.fd, short(events[i].events));
+        }
+        pollfds.clear();
+        return;
+    }
+#endif
+
     for (const pollfd &pfd : qAsConst(pollfds)) {
         if (pfd.fd < 0 || pfd.revents == 0)
             continue;
 
-        auto it = socketNotifiers.find(pfd.fd);
-        Q_ASSERT(it != socketNotifiers.end());
+        markPendingSocketNotifiers(pfd.fd, pfd.revents);
+    }
+
+    pollfds.clear();
+}
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(int fd, short revents)
+{
+    auto it = socketNotifiers.find(fd);
+#if QT_CONFIG(epoll)
+    // a descriptor that epoll still reports after it was closed and reused
+    if (epollFd >= 0 && it == socketNotifiers.end())
+        return;
+#endif
+    Q_ASSERT(it != socketNotifiers.end());
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+    const QSocketNotifierSetUNIX &sn_set = it.value();
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
 
-            if (!notifier)
-                continue;
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+        if (!notifier)
+            continue;
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     it.key(), socketType(n.type));
+            notifier->setEnabled(false);
         }
-    }
 
-    pollfds.clear();
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
 }
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
@@ -266,6 +356,21 @@ int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 
     while (!pendingNotifiers.isEmpty()) {
         QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        if (QSocketNotifierGroup *group = QSocketNotifierPrivate::get(notifier)->group) {
+            // deliver all the ready notifiers of the group at once
+            QList<QSocketNotifier *> ready = { notifier };
+            for (auto it = pendingNotifiers.begin(); it != pendingNotifiers.end(); ) {
+                if (QSocketNotifierPrivate::get(*it)->group == group) {
+                    ready.append(*it);
+                    it = pendingNotifiers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            n_activated += ready.size();
+            group->activate(ready);
+            continue;
+        }
         QCoreApplication::sendEvent(notifier, &event);
         ++n_activated;
     }
@@ -376,7 +481,14 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const uint oldEvents = epollEvents(sn_set);
+#endif
     sn_set.notifiers[type] = notifier;
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollInterest(sockfd, oldEvents, epollEvents(sn_set));
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -415,7 +527,14 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const uint oldEvents = epollEvents(sn_set);
+#endif
     sn_set.notifiers[type] = nullptr;
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollInterest(sockfd, oldEvents, epollEvents(sn_set));
+#endif
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -453,11 +572,22 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         tm = &wait_tm;
 
     d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0) {
+        // the epoll set is maintained by (un)registerSocketNotifier(), so
+        // waiting on it costs the same regardless of the number of notifiers
+        d->pollfds.reserve(2);
+        if (include_notifiers && !d->socketNotifiers.isEmpty())
+            d->pollfds.append(qt_make_pollfd(d->epollFd, POLLIN));
+    } else
+#endif
+    {
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
-    if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+    }
 
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
@@ -23,6 +23,10 @@
 #include "QtCore/qhash.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -100,11 +104,22 @@ public:
     int activateTimers();
 
     void markPendingSocketNotifiers();
+    void markPendingSocketNotifiers(int fd, short revents);
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollInterest(int fd, uint oldEvents, uint newEvents);
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
+#if QT_CONFIG(epoll)
+    // if >= 0, socket notifiers are kept registered in this epoll set
+    // and pollfds only ever contains the epoll fd itself
+    int epollFd = -1;
+#endif
 
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
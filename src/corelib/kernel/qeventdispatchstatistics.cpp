@@ -0,0 +1,290 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qeventdispatchstatistics_p.h"
+
+#include "qdebug.h"
+#include "qhash.h"
+#include "qloggingcategory.h"
+#include "qmetaobject.h"
+#include "qmutex.h"
+
+#include <algorithm>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(lcEventDispatchStatistics, "qt.core.eventdispatchstatistics")
+
+/*!
+    \internal
+    \class QEventDispatchStatistics
+    \inmodule QtCore
+
+    Collects how long events take to be delivered, per event type and class
+    of the receiver, so that whatever stalls an event loop can be found
+    without attaching a profiler. For each combination, a histogram of the
+    time spent in QCoreApplication::notify() is kept, and for posted events
+    also one of the time between QCoreApplication::postEvent() and the
+    delivery of the event.
+
+    Recording is disabled by default and then costs one relaxed atomic load
+    per event. It is enabled with setEnabled() or by setting the
+    \c QT_EVENT_DISPATCH_STATISTICS environment variable, in which case the
+    statistics are also written to the \c qt.core.eventdispatchstatistics
+    logging category when the application object is destroyed.
+
+    Every thread records into its own table, so threads don't contend with
+    each other; the tables of finished threads are merged into a common one.
+*/
+
+Q_CONSTINIT QBasicAtomicInteger<bool> QEventDispatchStatistics::enabled = Q_BASIC_ATOMIC_INITIALIZER(false);
+
+namespace {
+using Key = std::pair<int, const QMetaObject *>;
+using RecordHash = QHash<Key, QEventDispatchStatistics::Record>;
+
+struct ThreadTable
+{
+    QMutex mutex;
+    RecordHash records;
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QList<ThreadTable *> tables;
+    RecordHash finished;            // merged from threads that exited
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(Registry, registry)
+
+static void mergeRecords(RecordHash *into, const RecordHash &from)
+{
+    for (auto it = from.cbegin(), end = from.cend(); it != end; ++it) {
+        auto &record = (*into)[it.key()];
+        if (record.className.isNull()) {
+            record.type = it->type;
+            record.className = it->className;
+        }
+        record.dispatchTime.merge(it->dispatchTime);
+        record.queueWait.merge(it->queueWait);
+    }
+}
+
+// trivially destructible, so it remains usable while the thread exits
+Q_THREAD_LOCAL_CONSTINIT static thread_local ThreadTable *currentThreadTable = nullptr;
+Q_THREAD_LOCAL_CONSTINIT static thread_local bool threadTableFinished = false;
+
+struct ThreadTableCleanup
+{
+    ~ThreadTableCleanup()
+    {
+        ThreadTable *table = std::exchange(currentThreadTable, nullptr);
+        threadTableFinished = true;
+        if (!table)
+            return;
+        if (Registry *r = registry()) {
+            QMutexLocker locker(&r->mutex);
+            r->tables.removeOne(table);
+            mergeRecords(&r->finished, table->records);
+        }
+        delete table;
+    }
+};
+
+static ThreadTable *threadTable()
+{
+    if (Q_LIKELY(currentThreadTable) || threadTableFinished)
+        return currentThreadTable;
+    Registry *r = registry();
+    if (!r)
+        return nullptr;
+    static thread_local ThreadTableCleanup cleanup;
+    Q_UNUSED(cleanup);
+    auto table = new ThreadTable;
+    QMutexLocker locker(&r->mutex);
+    r->tables.append(table);
+    return currentThreadTable = table;
+}
+
+static int bucketFor(qint64 nsecs) noexcept
+{
+    const quint64 usecs = quint64(qMax(nsecs, qint64(0))) / 1000;
+    if (!usecs)
+        return 0;
+    return qMin(64 - int(qCountLeadingZeroBits(usecs)), int(QEventDispatchStatistics::BucketCount) - 1);
+}
+
+void QEventDispatchStatistics::Histogram::add(qint64 nsecs) noexcept
+{
+    ++count;
+    total += nsecs;
+    maximum = qMax(maximum, nsecs);
+    ++buckets[bucketFor(nsecs)];
+}
+
+void QEventDispatchStatistics::Histogram::merge(const Histogram &other) noexcept
+{
+    count += other.count;
+    total += other.total;
+    maximum = qMax(maximum, other.maximum);
+    for (int i = 0; i < BucketCount; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+/*!
+    \internal
+    Returns an upper bound for the duration that \a fraction of the recorded
+    durations don't exceed, in nanoseconds. The result is only as precise as
+    the buckets of the histogram.
+*/
+qint64 QEventDispatchStatistics::Histogram::percentile(double fraction) const noexcept
+{
+    if (!count)
+        return 0;
+    const quint64 wanted = qMax(quint64(1), quint64(fraction * double(count) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= wanted)
+            return qMin((qint64(1) << i) * 1000, maximum);
+    }
+    return maximum;
+}
+
+/*!
+    \internal
+    Enables or disables recording, depending on \a enable. Statistics
+    recorded earlier are kept.
+*/
+void QEventDispatchStatistics::setEnabled(bool enable) noexcept
+{
+    enabled.storeRelaxed(enable);
+}
+
+/*!
+    \internal
+    Returns the current time on the clock used for measuring, in nanoseconds.
+*/
+qint64 QEventDispatchStatistics::timestamp() noexcept
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename Member>
+static void record(const QMetaObject *receiverClass, QEvent::Type type, qint64 nsecs, Member member)
+{
+    ThreadTable *table = threadTable();
+    if (!table)
+        return;
+    QMutexLocker locker(&table->mutex);
+    auto &record = table->records[Key(type, receiverClass)];
+    if (record.className.isNull()) {
+        record.type = type;
+        // copied, as the class may be unloaded with its plugin
+        record.className = receiverClass ? QByteArray(receiverClass->className()) : QByteArray("");
+    }
+    (record.*member).add(nsecs);
+}
+
+/*!
+    \internal
+    Records that delivering an event of type \a type to an object of class
+    \a receiverClass took \a nsecs nanoseconds.
+*/
+void QEventDispatchStatistics::recordDispatch(const QMetaObject *receiverClass, QEvent::Type type,
+                                              qint64 nsecs)
+{
+    record(receiverClass, type, nsecs, &Record::dispatchTime);
+}
+
+/*!
+    \internal
+    Records that a posted event of type \a type for an object of class
+    \a receiverClass waited \a nsecs nanoseconds in the queue of its thread.
+*/
+void QEventDispatchStatistics::recordQueueWait(const QMetaObject *receiverClass, QEvent::Type type,
+                                               qint64 nsecs)
+{
+    record(receiverClass, type, nsecs, &Record::queueWait);
+}
+
+/*!
+    \internal
+    Returns the statistics recorded so far in all threads, one record per
+    event type and receiver class.
+*/
+QList<QEventDispatchStatistics::Record> QEventDispatchStatistics::snapshot()
+{
+    Registry *r = registry();
+    if (!r)
+        return {};
+
+    QMutexLocker locker(&r->mutex);
+    RecordHash merged = r->finished;
+    for (ThreadTable *table : std::as_const(r->tables)) {
+        QMutexLocker tableLocker(&table->mutex);
+        mergeRecords(&merged, table->records);
+    }
+    locker.unlock();
+
+    QList<Record> result;
+    result.reserve(merged.size());
+    for (auto it = merged.cbegin(), end = merged.cend(); it != end; ++it)
+        result.append(*it);
+    return result;
+}
+
+/*!
+    \internal
+    Discards the statistics recorded so far.
+*/
+void QEventDispatchStatistics::reset()
+{
+    Registry *r = registry();
+    if (!r)
+        return;
+
+    QMutexLocker locker(&r->mutex);
+    r->finished.clear();
+    for (ThreadTable *table : std::as_const(r->tables)) {
+        QMutexLocker tableLocker(&table->mutex);
+        table->records.clear();
+    }
+}
+
+/*!
+    \internal
+    Writes the \a maxRecords records with the longest total dispatch time to
+    the \c qt.core.eventdispatchstatistics logging category. Times are
+    printed in microseconds.
+*/
+void QEventDispatchStatistics::dump(qsizetype maxRecords)
+{
+    if (!lcEventDispatchStatistics().isInfoEnabled())
+        return;
+
+    QList<Record> records = snapshot();
+    std::sort(records.begin(), records.end(), [](const Record &a, const Record &b) {
+        return a.dispatchTime.total > b.dispatchTime.total;
+    });
+    if (records.size() > maxRecords)
+        records.resize(maxRecords);
+
+    for (const Record &r : std::as_const(records)) {
+        const Histogram &d = r.dispatchTime;
+        const Histogram &w = r.queueWait;
+        qCInfo(lcEventDispatchStatistics).nospace()
+                << r.type << " to " << r.className.constData() << ": "
+                << d.count << " dispatched, total " << d.total / 1000
+                << ", mean " << d.mean() / 1000 << ", p99 " << d.percentile(0.99) / 1000
+                << ", max " << d.maximum / 1000 << "; " << w.count << " queued, mean wait "
+                << w.mean() / 1000 << ", p99 " << w.percentile(0.99) / 1000
+                << ", max " << w.maximum / 1000;
+    }
+}
+
+QT_END_NAMESPACE
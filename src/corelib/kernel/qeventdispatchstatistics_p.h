@@ -0,0 +1,77 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTDISPATCHSTATISTICS_P_H
+#define QEVENTDISPATCHSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qlist.h>
+
+#include <array>
+
+QT_BEGIN_NAMESPACE
+
+struct QMetaObject;
+
+class Q_CORE_EXPORT QEventDispatchStatistics
+{
+public:
+    enum { BucketCount = 32 };
+
+    // bucket 0 counts durations below one microsecond, bucket i > 0 those
+    // in [2^(i-1), 2^i) microseconds; the last one also counts anything longer
+    struct Histogram
+    {
+        quint64 count = 0;
+        qint64 total = 0;           // nanoseconds
+        qint64 maximum = 0;         // nanoseconds
+        std::array<quint64, BucketCount> buckets = {};
+
+        void add(qint64 nsecs) noexcept;
+        void merge(const Histogram &other) noexcept;
+        qint64 mean() const noexcept { return count ? qint64(total / count) : 0; }
+        qint64 percentile(double fraction) const noexcept;
+    };
+
+    struct Record
+    {
+        QEvent::Type type = QEvent::None;
+        QByteArray className;       // of the receiver
+        Histogram dispatchTime;     // in QCoreApplication::notify(), including nested events
+        Histogram queueWait;        // from postEvent() to delivery, for posted events only
+    };
+
+    static bool isEnabled() noexcept { return enabled.loadRelaxed(); }
+    static void setEnabled(bool enable) noexcept;
+
+    static QList<Record> snapshot();
+    static void reset();
+    static void dump(qsizetype maxRecords = 20);
+
+    static qint64 timestamp() noexcept;
+    static void recordDispatch(const QMetaObject *receiverClass, QEvent::Type type, qint64 nsecs);
+    static void recordQueueWait(const QMetaObject *receiverClass, QEvent::Type type, qint64 nsecs);
+
+private:
+    Q_CONSTINIT static QBasicAtomicInteger<bool> enabled;
+};
+
+Q_DECLARE_TYPEINFO(QEventDispatchStatistics::Record, Q_RELOCATABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QEVENTDISPATCHSTATISTICS_P_H
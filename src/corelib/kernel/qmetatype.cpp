@@ -58,6 +58,8 @@
 #include <bitset>
 #include <new>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,9 +71,155 @@ namespace {
 
 struct QMetaTypeCustomRegistry
 {
+    using Interface = const QtPrivate::QMetaTypeInterface;
+    using Slot = QBasicAtomicPointer<Interface>;
+
+    // Lookups by id or name happen far more often than registrations and
+    // must not contend on the lock, so both indexes below are read without
+    // it. Writers are serialized by the lock and only ever publish new
+    // memory; nothing a reader may still see is moved or freed until the
+    // registry itself is destroyed.
+
+    // Append-only storage of the types by id. Chunk n holds
+    // FirstChunkSize << n types, so the chunks never need to be reallocated.
+    struct IdTable
+    {
+        static constexpr qsizetype FirstChunkSize = 64;
+        static constexpr int MaxChunks = 24;
+        QBasicAtomicPointer<Slot> chunks[MaxChunks] = {};
+
+        ~IdTable()
+        {
+            for (auto &chunk : chunks)
+                delete[] chunk.loadRelaxed();
+        }
+
+        static std::pair<int, qsizetype> locate(qsizetype idx)
+        {
+            // chunk c starts at index FirstChunkSize * (2^c - 1)
+            const quint64 n = quint64(idx) / FirstChunkSize + 1;
+            const int chunk = 63 - qCountLeadingZeroBits(n);
+            return { chunk, idx - FirstChunkSize * ((qsizetype(1) << chunk) - 1) };
+        }
+
+        Interface *value(qsizetype idx) const
+        {
+            if (idx < 0)
+                return nullptr;
+            const auto [chunk, offset] = locate(idx);
+            if (chunk >= MaxChunks)
+                return nullptr;
+            const Slot *buckets = chunks[chunk].loadAcquire();
+            return buckets ? buckets[offset].loadAcquire() : nullptr;
+        }
+
+        // must be called with the lock held for writing
+        void setValue(qsizetype idx, Interface *iface)
+        {
+            const auto [chunk, offset] = locate(idx);
+            Q_ASSERT(chunk < MaxChunks);
+            Slot *buckets = chunks[chunk].loadRelaxed();
+            if (!buckets) {
+                buckets = new Slot[FirstChunkSize << chunk]();
+                chunks[chunk].storeRelease(buckets);
+            }
+            buckets[offset].storeRelease(iface);
+        }
+    };
+
+    // Insert-only open addressing hash table of all the names (official
+    // names and typedefs) known to the registry. Entries are immutable
+    // except for the type they map to, which is reset to null when the type
+    // is unregistered. The table is replaced by a larger copy when it gets
+    // half full; older tables are retired, not freed, as readers may still
+    // be probing them.
+    struct NameIndex
+    {
+        struct Entry
+        {
+            QByteArray name;
+            size_t hash;
+            Slot type;
+        };
+        struct Table
+        {
+            explicit Table(qsizetype capacity)
+                : mask(capacity - 1), buckets(new QBasicAtomicPointer<Entry>[capacity]())
+            {}
+            const qsizetype mask;
+            const std::unique_ptr<QBasicAtomicPointer<Entry>[]> buckets;
+            std::unique_ptr<Table> retired;
+        };
+
+        QBasicAtomicPointer<Table> table = {};
+        std::vector<std::unique_ptr<Entry>> entries;    // in insertion order
+
+        ~NameIndex()
+        {
+            delete table.loadRelaxed();
+        }
+
+        static size_t hashName(QByteArrayView name) { return qHash(name, 0); }
+
+        static Entry *find(const Table *t, QByteArrayView name, size_t hash)
+        {
+            for (qsizetype i = hash & t->mask; ; i = (i + 1) & t->mask) {
+                Entry *e = t->buckets[i].loadAcquire();
+                if (!e || (e->hash == hash && e->name == name))
+                    return e;
+            }
+        }
+
+        Interface *value(QByteArrayView name) const
+        {
+            const Table *t = table.loadAcquire();
+            if (!t)
+                return nullptr;
+            const Entry *e = find(t, name, hashName(name));
+            return e ? e->type.loadAcquire() : nullptr;
+        }
+
+        // must be called with the lock held for writing
+        Entry *findOrInsert(const QByteArray &name)
+        {
+            const size_t hash = hashName(name);
+            Table *t = table.loadRelaxed();
+            if (t) {
+                if (Entry *e = find(t, name, hash))
+                    return e;
+            }
+            if (!t || qsizetype(entries.size()) >= (t->mask + 1) / 2)
+                t = grow(t);
+
+            entries.push_back(std::unique_ptr<Entry>(new Entry{ name, hash, {} }));
+            Entry *e = entries.back().get();
+            qsizetype i = hash & t->mask;
+            while (t->buckets[i].loadRelaxed())
+                i = (i + 1) & t->mask;
+            t->buckets[i].storeRelease(e);
+            return e;
+        }
+
+        Table *grow(Table *old)
+        {
+            auto t = new Table(old ? 2 * (old->mask + 1) : 64);
+            for (const auto &e : entries) {
+                qsizetype i = e->hash & t->mask;
+                while (t->buckets[i].loadRelaxed())
+                    i = (i + 1) & t->mask;
+                t->buckets[i].storeRelaxed(e.get());
+            }
+            t->retired.reset(old);
+            table.storeRelease(t);
+            return t;
+        }
+    };
+
     QReadWriteLock lock;
-    QList<const QtPrivate::QMetaTypeInterface *> registry;
-    QHash<QByteArray, const QtPrivate::QMetaTypeInterface *> aliases;
+    IdTable registry;
+    NameIndex aliases;
+    // number of ids in use or freed in registry
+    int registrySize = 0;
     // index of first empty (unregistered) type in registry, if any.
     int firstEmpty = 0;
 
@@ -89,22 +237,21 @@ struct QMetaTypeCustomRegistry
                     QMetaObject::normalizedType
 #endif
                     (ti->name);
-            if (auto ti2 = aliases.value(name)) {
+            NameIndex::Entry *alias = aliases.findOrInsert(name);
+            if (auto ti2 = alias->type.loadRelaxed()) {
                 ti->typeId.storeRelaxed(ti2->typeId.loadRelaxed());
                 return ti2->typeId;
             }
-            aliases[name] = ti;
-            int size = registry.size();
-            while (firstEmpty < size && registry[firstEmpty])
+            while (firstEmpty < registrySize && registry.value(firstEmpty))
                 ++firstEmpty;
-            if (firstEmpty < size) {
-                registry[firstEmpty] = ti;
-                ++firstEmpty;
-            } else {
-                registry.append(ti);
-                firstEmpty = registry.size();
-            }
-            ti->typeId.storeRelaxed(firstEmpty + QMetaType::User);
+            registry.setValue(firstEmpty, ti);
+            if (firstEmpty == registrySize)
+                ++registrySize;
+            ++firstEmpty;
+            // publish the id before the name, so that a lookup by name never
+            // finds an interface whose id is still unset
+            ti->typeId.storeRelease(firstEmpty + QMetaType::User);
+            alias->type.storeRelease(ti);
         }
         if (ti->legacyRegisterOp)
             ti->legacyRegisterOp();
@@ -118,26 +265,22 @@ struct QMetaTypeCustomRegistry
         Q_ASSERT(id > QMetaType::User);
         QWriteLocker l(&lock);
         int idx = id - QMetaType::User - 1;
-        auto &ti = registry[idx];
+        Interface *ti = registry.value(idx);
 
         // We must unregister all names.
-        auto it = aliases.begin();
-        while (it != aliases.end()) {
-            if (it.value() == ti)
-                it = aliases.erase(it);
-            else
-                ++it;
+        for (const auto &e : aliases.entries) {
+            if (e->type.loadRelaxed() == ti)
+                e->type.storeRelease(nullptr);
         }
 
-        ti = nullptr;
+        registry.setValue(idx, nullptr);
 
         firstEmpty = std::min(firstEmpty, idx);
     }
 
     const QtPrivate::QMetaTypeInterface *getCustomType(int id)
     {
-        QReadLocker l(&lock);
-        return registry.value(id - QMetaType::User - 1);
+        return registry.value(qsizetype(id) - QMetaType::User - 1);
     }
 };
 
@@ -156,14 +299,14 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
 
     QByteArrayView officialName(type_d->name);
     QReadLocker l(&r->lock);
-    auto it = r->aliases.constBegin();
-    auto end = r->aliases.constEnd();
+    auto it = r->aliases.entries.cbegin();
+    auto end = r->aliases.entries.cend();
     for ( ; it != end; ++it) {
-        if (it.value() != type_d)
+        if ((*it)->type.loadRelaxed() != type_d)
             continue;
-        if (it.key() == officialName)
+        if ((*it)->name == officialName)
             continue;               // skip the official name
-        name = it.key().constData();
+        name = (*it)->name.constData();
         ++it;
         break;
     }
@@ -171,8 +314,8 @@ const char *QtMetaTypePrivate::typedefNameForType(const QtPrivate::QMetaTypeInte
 #ifndef QT_NO_DEBUG
     QByteArrayList otherNames;
     for ( ; it != end; ++it) {
-        if (it.value() == type_d && it.key() != officialName)
-            otherNames << it.key();
+        if ((*it)->type.loadRelaxed() == type_d && (*it)->name != officialName)
+            otherNames << (*it)->name;
     }
     l.unlock();
     if (!otherNames.isEmpty())
@@ -2555,19 +2698,14 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
+    types. The name index is read without locking the registry.
 
 */
 static int qMetaTypeCustomType_unlocked(const char *typeName, int length)
 {
     if (customTypeRegistry.exists()) {
-        auto reg = &*customTypeRegistry;
-#if QT_CONFIG(thread)
-        Q_ASSERT(!reg->lock.tryLockForWrite());
-#endif
-        if (auto ti = reg->aliases.value(QByteArray::fromRawData(typeName, length), nullptr)) {
-            return ti->typeId;
-        }
+        if (auto ti = customTypeRegistry->aliases.value(QByteArrayView(typeName, length)))
+            return ti->typeId.loadAcquire();
     }
     return QMetaType::UnknownType;
 }
@@ -2586,10 +2724,10 @@ void QMetaType::registerNormalizedTypedef(const NS(QByteArray) & normalizedTypeN
         return;
     if (auto reg = customTypeRegistry()) {
         QWriteLocker lock(&reg->lock);
-        auto &al = reg->aliases[normalizedTypeName];
-        if (al)
+        auto al = reg->aliases.findOrInsert(normalizedTypeName);
+        if (al->type.loadRelaxed())
             return;
-        al = metaType.d_ptr;
+        al->type.storeRelease(metaType.d_ptr);
     }
 }
 
@@ -2625,7 +2763,6 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(&customTypeRegistry()->lock);
         type = qMetaTypeCustomType_unlocked(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
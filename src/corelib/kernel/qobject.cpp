@@ -304,6 +304,7 @@ inline void QObjectPrivate::addConnection(int signal, Connection *c)
     c->id = ++cd->currentConnectionId;
     c->prevConnectionList = connectionList.last.loadRelaxed();
     connectionList.last.storeRelaxed(c);
+    cd->appendToConnectionArray(connectionList, c);
 
     QObjectPrivate *rd = QObjectPrivate::get(c->receiver.loadRelaxed());
     rd->ensureConnectionData();
@@ -356,6 +357,7 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
     if (c->prevConnectionList)
         c->prevConnectionList->nextConnectionList.storeRelaxed(n);
     c->prevConnectionList = nullptr;
+    dropConnectionArray(connections);
 
     Q_ASSERT(c != orphaned.loadRelaxed());
     // add c to orphanedConnections
@@ -381,6 +383,68 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
 
 }
 
+/*!
+  \internal
+  Builds the ConnectionArray of the connections to \a signal, unless it
+  already exists. The list is read from the current signal vector, which
+  might have been replaced since the caller looked up the list.
+ */
+void QObjectPrivate::ConnectionData::buildConnectionArray(int signal)
+{
+    SignalVector *vector = signalVector.loadRelaxed();
+    if (!vector || signal >= vector->count())
+        return;
+    ConnectionList &list = vector->at(signal);
+    if (list.flat.loadRelaxed())
+        return;
+
+    int count = 0;
+    for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed())
+        ++count;
+    if (count < ConnectionArrayThreshold)
+        return;
+
+    // leave room for some more connections before the array needs to grow
+    ConnectionArray *array = ConnectionArray::create(count + count / 2);
+    Connection **it = array->data();
+    for (Connection *c = list.first.loadRelaxed(); c; c = c->nextConnectionList.loadRelaxed())
+        *it++ = c;
+    array->count.storeRelaxed(count);
+    list.flat.storeRelease(array);
+}
+
+void QObjectPrivate::ConnectionData::appendToConnectionArray(ConnectionList &list, Connection *c)
+{
+    ConnectionArray *array = list.flat.loadRelaxed();
+    if (!array)
+        return;
+
+    const int count = array->count.loadRelaxed();
+    if (count < array->capacity) {
+        // activations in progress only read the entries below the count
+        // they loaded, so this entry can be written in place
+        array->data()[count] = c;
+        array->count.storeRelease(count + 1);
+        return;
+    }
+
+    ConnectionArray *grown = ConnectionArray::create(2 * array->capacity);
+    memcpy(grown->data(), array->data(), count * sizeof(Connection *));
+    grown->data()[count] = c;
+    grown->count.storeRelaxed(count + 1);
+    list.flat.storeRelease(grown);
+    // activations in progress might still be reading the old array
+    orphanConnectionArray(array);
+}
+
+void QObjectPrivate::ConnectionData::dropConnectionArray(ConnectionList &list)
+{
+    if (ConnectionArray *array = list.flat.loadRelaxed()) {
+        list.flat.storeRelease(nullptr);
+        orphanConnectionArray(array);
+    }
+}
+
 void QObjectPrivate::ConnectionData::cleanOrphanedConnectionsImpl(QObject *sender, LockPolicy lockPolicy)
 {
     QBasicMutex *senderMutex = signalSlotLock(sender);
@@ -416,6 +480,9 @@ inline void QObjectPrivate::ConnectionData::deleteOrphaned(QObjectPrivate::Conne
         if (SignalVector *v = ConnectionOrSignalVector::asSignalVector(o)) {
             next = v->nextInOrphanList;
             free(v);
+        } else if (ConnectionArray *a = ConnectionOrSignalVector::asConnectionArray(o)) {
+            next = a->nextInOrphanList;
+            free(a);
         } else {
             QObjectPrivate::Connection *c = static_cast<Connection *>(o);
             next = c->nextInOrphanList;
@@ -497,6 +564,172 @@ QAbstractMetaCallEvent::~QAbstractMetaCallEvent()
 #endif
 }
 
+namespace {
+/*
+    Every queued emission allocates a QMetaCallEvent in the emitting thread,
+    which is then deleted in the receiving thread. To keep that out of the
+    allocator, each thread keeps a small cache of event blocks it allocated.
+    Blocks deleted in the allocating thread go straight back to its cache;
+    blocks deleted in other threads are pushed onto a lock-free stack, which
+    the owning thread takes over as a whole when its cache runs dry.
+
+    The pool is reference counted by its thread and by the blocks it has
+    handed out, so blocks may outlive the thread that allocated them.
+*/
+struct QMetaCallEventPool
+{
+    struct Block
+    {
+        QMetaCallEventPool *pool;
+        Block *next;
+        alignas(QMetaCallEvent) char storage[sizeof(QMetaCallEvent)];
+    };
+    enum { MaxCachedBlocks = 128 };
+
+    // owner thread only
+    Block *freeBlocks = nullptr;
+    int freeCount = 0;
+    quint64 hits = 0;
+    quint64 misses = 0;
+
+    QAtomicPointer<Block> remoteFreeBlocks;
+    QAtomicInt remoteFreeCount;
+    QAtomicInt ref = 1;
+
+    static void freeBlockList(Block *list)
+    {
+        while (list) {
+            Block *next = list->next;
+            ::operator delete(list);
+            list = next;
+        }
+    }
+
+    void deref()
+    {
+        if (!ref.deref()) {
+            freeBlockList(freeBlocks);
+            freeBlockList(remoteFreeBlocks.fetchAndStoreAcquire(nullptr));
+            delete this;
+        }
+    }
+
+    Block *allocate()
+    {
+        if (!freeBlocks && remoteFreeBlocks.loadRelaxed()) {
+            freeBlocks = remoteFreeBlocks.fetchAndStoreAcquire(nullptr);
+            freeCount += remoteFreeCount.fetchAndStoreRelaxed(0);
+        }
+
+        Block *block = freeBlocks;
+        if (block) {
+            freeBlocks = block->next;
+            --freeCount;
+            ++hits;
+        } else {
+            block = static_cast<Block *>(::operator new(sizeof(Block)));
+            block->pool = this;
+            ++misses;
+        }
+        ref.ref();
+        Q_TRACE(QMetaCallEvent_allocate, true, hits, misses);
+        return block;
+    }
+
+    void releaseLocal(Block *block)
+    {
+        if (freeCount < MaxCachedBlocks) {
+            block->next = freeBlocks;
+            freeBlocks = block;
+            ++freeCount;
+        } else {
+            ::operator delete(block);
+        }
+        deref();
+    }
+
+    void releaseRemote(Block *block)
+    {
+        if (remoteFreeCount.fetchAndAddRelaxed(1) < MaxCachedBlocks) {
+            Block *head = remoteFreeBlocks.loadRelaxed();
+            do {
+                block->next = head;
+            } while (!remoteFreeBlocks.testAndSetRelease(head, block, head));
+        } else {
+            remoteFreeCount.fetchAndSubRelaxed(1);
+            ::operator delete(block);
+        }
+        deref();
+    }
+};
+
+// trivially destructible, so they remain usable while the thread exits
+Q_THREAD_LOCAL_CONSTINIT static thread_local QMetaCallEventPool *currentMetaCallEventPool = nullptr;
+Q_THREAD_LOCAL_CONSTINIT static thread_local bool metaCallEventPoolFinished = false;
+
+struct QMetaCallEventPoolCleanup
+{
+    ~QMetaCallEventPoolCleanup()
+    {
+        QMetaCallEventPool *pool = std::exchange(currentMetaCallEventPool, nullptr);
+        metaCallEventPoolFinished = true;
+        if (!pool)
+            return;
+        QMetaCallEventPool::freeBlockList(std::exchange(pool->freeBlocks, nullptr));
+        pool->freeCount = 0;
+        pool->deref();
+    }
+};
+
+static QMetaCallEventPool *metaCallEventPool()
+{
+    if (Q_LIKELY(currentMetaCallEventPool) || metaCallEventPoolFinished)
+        return currentMetaCallEventPool;
+    static thread_local QMetaCallEventPoolCleanup cleanup;
+    Q_UNUSED(cleanup);
+    return currentMetaCallEventPool = new QMetaCallEventPool;
+}
+} // unnamed namespace
+
+/*!
+    \internal
+ */
+void *QMetaCallEvent::operator new(std::size_t size)
+{
+    using Block = QMetaCallEventPool::Block;
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator new(size); // a derived class
+
+    Block *block;
+    if (QMetaCallEventPool *pool = metaCallEventPool()) {
+        block = pool->allocate();
+    } else {
+        // allocated while the thread exits
+        block = static_cast<Block *>(::operator new(sizeof(Block)));
+        block->pool = nullptr;
+        Q_TRACE(QMetaCallEvent_allocate, false, 0, 0);
+    }
+    return block->storage;
+}
+
+/*!
+    \internal
+ */
+void QMetaCallEvent::operator delete(void *ptr, std::size_t size) noexcept
+{
+    using Block = QMetaCallEventPool::Block;
+    if (size != sizeof(QMetaCallEvent))
+        return ::operator delete(ptr);
+
+    Block *block = reinterpret_cast<Block *>(static_cast<char *>(ptr) - offsetof(Block, storage));
+    if (!block->pool)
+        ::operator delete(block);
+    else if (block->pool == currentMetaCallEventPool)
+        block->pool->releaseLocal(block);
+    else
+        block->pool->releaseRemote(block);
+}
+
 /*!
     \internal
  */
@@ -1679,6 +1912,7 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
 
     // move posted events
     int eventsMoved = 0;
+    currentData->takePendingPostedEvents();
     for (int i = 0; i < currentData->postEventList.size(); ++i) {
         const QPostEvent &pe = currentData->postEventList.at(i);
         if (!pe.event)
@@ -3891,108 +4125,129 @@ void doActivate(QObject *sender, int signal_index, void **argv)
     // We need to check against the highest connection id to ensure that signals added
     // during the signal emission are not emitted in this emission.
     uint highestConnectionId = connections->currentConnectionId.loadRelaxed();
-    do {
-        QObjectPrivate::Connection *c = list->first.loadRelaxed();
-        if (!c)
-            continue;
-
-        do {
-            QObject * const receiver = c->receiver.loadRelaxed();
-            if (!receiver)
-                continue;
+    auto activateConnection = [&](QObjectPrivate::Connection *c) {
+        QObject * const receiver = c->receiver.loadRelaxed();
+        if (!receiver)
+            return;
 
-            QThreadData *td = c->receiverThreadData.loadRelaxed();
-            if (!td)
-                continue;
+        QThreadData *td = c->receiverThreadData.loadRelaxed();
+        if (!td)
+            return;
 
-            bool receiverInSameThread;
-            if (inSenderThread) {
-                receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
-            } else {
-                // need to lock before reading the threadId, because moveToThread() could interfere
-                QMutexLocker lock(signalSlotLock(receiver));
-                receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
-            }
+        bool receiverInSameThread;
+        if (inSenderThread) {
+            receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
+        } else {
+            // need to lock before reading the threadId, because moveToThread() could interfere
+            QMutexLocker lock(signalSlotLock(receiver));
+            receiverInSameThread = currentThreadId == td->threadId.loadRelaxed();
+        }
 
 
-            // determine if this connection should be sent immediately or
-            // put into the event queue
-            if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
-                || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv);
-                continue;
+        // determine if this connection should be sent immediately or
+        // put into the event queue
+        if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
+            || (c->connectionType == Qt::QueuedConnection)) {
+            queued_activate(sender, signal_index, c, argv);
+            return;
 #if QT_CONFIG(thread)
-            } else if (c->connectionType == Qt::BlockingQueuedConnection) {
-                if (receiverInSameThread) {
-                    qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
-                    "Sender is %s(%p), receiver is %s(%p)",
-                    sender->metaObject()->className(), sender,
-                    receiver->metaObject()->className(), receiver);
-                }
-
-                if (c->isSingleShot && !QObjectPrivate::removeConnection(c))
-                    continue;
-
-                QSemaphore semaphore;
-                {
-                    QBasicMutexLocker locker(signalSlotLock(receiver));
-                    if (!c->isSingleShot && !c->receiver.loadAcquire())
-                        continue;
-                    QMetaCallEvent *ev = c->isSlotObject ?
-                        new QMetaCallEvent(c->slotObj, sender, signal_index, argv, &semaphore) :
-                        new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction,
-                                           sender, signal_index, argv, &semaphore);
-                    QCoreApplication::postEvent(receiver, ev);
-                }
-                semaphore.acquire();
-                continue;
-#endif
+        } else if (c->connectionType == Qt::BlockingQueuedConnection) {
+            if (receiverInSameThread) {
+                qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
+                "Sender is %s(%p), receiver is %s(%p)",
+                sender->metaObject()->className(), sender,
+                receiver->metaObject()->className(), receiver);
             }
 
             if (c->isSingleShot && !QObjectPrivate::removeConnection(c))
-                continue;
+                return;
+
+            QSemaphore semaphore;
+            {
+                QBasicMutexLocker locker(signalSlotLock(receiver));
+                if (!c->isSingleShot && !c->receiver.loadAcquire())
+                    return;
+                QMetaCallEvent *ev = c->isSlotObject ?
+                    new QMetaCallEvent(c->slotObj, sender, signal_index, argv, &semaphore) :
+                    new QMetaCallEvent(c->method_offset, c->method_relative, c->callFunction,
+                                       sender, signal_index, argv, &semaphore);
+                QCoreApplication::postEvent(receiver, ev);
+            }
+            semaphore.acquire();
+            return;
+#endif
+        }
 
-            QObjectPrivate::Sender senderData(receiverInSameThread ? receiver : nullptr, sender, signal_index);
+        if (c->isSingleShot && !QObjectPrivate::removeConnection(c))
+            return;
 
-            if (c->isSlotObject) {
-                SlotObjectGuard obj{c->slotObj};
+        QObjectPrivate::Sender senderData(receiverInSameThread ? receiver : nullptr, sender, signal_index);
 
-                {
-                    Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, c->slotObj);
-                    obj->call(receiver, argv);
-                }
-            } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
-                //we compare the vtable to make sure we are not in the destructor of the object.
-                const int method_relative = c->method_relative;
-                const auto callFunction = c->callFunction;
-                const int methodIndex = (Q_HAS_TRACEPOINTS || callbacks_enabled) ? c->method() : 0;
-                if (callbacks_enabled && signal_spy_set->slot_begin_callback != nullptr)
-                    signal_spy_set->slot_begin_callback(receiver, methodIndex, argv);
-
-                {
-                    Q_TRACE_SCOPE(QMetaObject_activate_slot, receiver, methodIndex);
-                    callFunction(receiver, QMetaObject::InvokeMetaMethod, method_relative, argv);
-                }
+        if (c->isSlotObject) {
+            SlotObjectGuard obj{c->slotObj};
 
-                if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
-                    signal_spy_set->slot_end_callback(receiver, methodIndex);
-            } else {
-                const int method = c->method_relative + c->method_offset;
+            {
+                Q_TRACE_SCOPE(QMetaObject_activate_slot_functor, c->slotObj);
+                obj->call(receiver, argv);
+            }
+        } else if (c->callFunction && c->method_offset <= receiver->metaObject()->methodOffset()) {
+            //we compare the vtable to make sure we are not in the destructor of the object.
+            const int method_relative = c->method_relative;
+            const auto callFunction = c->callFunction;
+            const int methodIndex = (Q_HAS_TRACEPOINTS || callbacks_enabled) ? c->method() : 0;
+            if (callbacks_enabled && signal_spy_set->slot_begin_callback != nullptr)
+                signal_spy_set->slot_begin_callback(receiver, methodIndex, argv);
+
+            {
+                Q_TRACE_SCOPE(QMetaObject_activate_slot, receiver, methodIndex);
+                callFunction(receiver, QMetaObject::InvokeMetaMethod, method_relative, argv);
+            }
 
-                if (callbacks_enabled && signal_spy_set->slot_begin_callback != nullptr) {
-                    signal_spy_set->slot_begin_callback(receiver, method, argv);
-                }
+            if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
+                signal_spy_set->slot_end_callback(receiver, methodIndex);
+        } else {
+            const int method = c->method_relative + c->method_offset;
 
-                {
-                    Q_TRACE_SCOPE(QMetaObject_activate_slot, receiver, method);
-                    QMetaObject::metacall(receiver, QMetaObject::InvokeMetaMethod, method, argv);
-                }
+            if (callbacks_enabled && signal_spy_set->slot_begin_callback != nullptr) {
+                signal_spy_set->slot_begin_callback(receiver, method, argv);
+            }
 
-                if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
-                    signal_spy_set->slot_end_callback(receiver, method);
+            {
+                Q_TRACE_SCOPE(QMetaObject_activate_slot, receiver, method);
+                QMetaObject::metacall(receiver, QMetaObject::InvokeMetaMethod, method, argv);
             }
+
+            if (callbacks_enabled && signal_spy_set->slot_end_callback != nullptr)
+                signal_spy_set->slot_end_callback(receiver, method);
+        }
+    };
+
+    do {
+        if (const QObjectPrivate::ConnectionArray *flat = list->flat.loadAcquire()) {
+            Q_ASSERT(flat->count.loadRelaxed() > 0);
+            QObjectPrivate::Connection *const *it = flat->data();
+            QObjectPrivate::Connection *const *end = it + flat->count.loadAcquire();
+            do {
+                activateConnection(*it);
+            } while (++it != end && (*it)->id <= highestConnectionId);
+            continue;
+        }
+
+        QObjectPrivate::Connection *c = list->first.loadRelaxed();
+        if (!c)
+            continue;
+
+        int length = 0;
+        do {
+            activateConnection(c);
+            ++length;
         } while ((c = c->nextConnectionList.loadRelaxed()) != nullptr && c->id <= highestConnectionId);
 
+        if (length >= QObjectPrivate::ConnectionData::ConnectionArrayThreshold
+                && connections->currentConnectionId.loadRelaxed() != 0) {
+            QBasicMutexLocker locker(signalSlotLock(sender));
+            connections->buildConnectionArray(list == &signalVector->at(-1) ? -1 : signal_index);
+        }
     } while (list != &signalVector->at(-1) &&
         //start over for all signals;
         ((list = &signalVector->at(-1)), true));
@@ -98,6 +98,7 @@ public:
 
     typedef void (*StaticMetaCallFunction)(QObject *, QMetaObject::Call, int, void **);
     struct Connection;
+    struct ConnectionArray;
     struct ConnectionData;
     struct ConnectionList;
     struct ConnectionOrSignalVector;
@@ -397,6 +398,10 @@ public:
 
     virtual void placeMetaCall(QObject *object) override;
 
+    // recycled through a per-thread pool, see qobject.cpp
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
 private:
     inline void allocArgs();
 
@@ -408,8 +413,8 @@ private:
         ushort method_offset_;
         ushort method_relative_;
     } d;
-    // preallocate enough space for three arguments
-    alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+    // preallocate enough space for the return value and four arguments
+    alignas(void *) char prealloc_[5 * sizeof(void *) + 5 * sizeof(QMetaType)];
 };
 
 class QBoolBlocker
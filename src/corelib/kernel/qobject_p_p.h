@@ -25,11 +25,13 @@
 
 QT_BEGIN_NAMESPACE
 
-// ConnectionList is a singly-linked list
+// ConnectionList is a singly-linked list. Long lists also have a flat copy
+// (see ConnectionArray) that is used for activation.
 struct QObjectPrivate::ConnectionList
 {
     QAtomicPointer<Connection> first;
     QAtomicPointer<Connection> last;
+    QAtomicPointer<ConnectionArray> flat;
 };
 static_assert(std::is_trivially_destructible_v<QObjectPrivate::ConnectionList>);
 Q_DECLARE_TYPEINFO(QObjectPrivate::ConnectionList, Q_RELOCATABLE_TYPE);
@@ -53,6 +55,16 @@ struct QObjectPrivate::ConnectionOrSignalVector
     {
         return reinterpret_cast<Connection *>(reinterpret_cast<quintptr>(v) | quintptr(1u));
     }
+    static ConnectionArray *asConnectionArray(ConnectionOrSignalVector *c)
+    {
+        if (reinterpret_cast<quintptr>(c) & 2)
+            return reinterpret_cast<ConnectionArray *>(reinterpret_cast<quintptr>(c) & ~quintptr(2u));
+        return nullptr;
+    }
+    static Connection *fromConnectionArray(ConnectionArray *a)
+    {
+        return reinterpret_cast<Connection *>(reinterpret_cast<quintptr>(a) | quintptr(2u));
+    }
 };
 static_assert(std::is_trivial_v<QObjectPrivate::ConnectionOrSignalVector>);
 
@@ -123,6 +135,31 @@ struct QObjectPrivate::SignalVector : public ConnectionOrSignalVector
 static_assert(
         std::is_trivial_v<QObjectPrivate::SignalVector>); // it doesn't need to be, but it helps
 
+// ConnectionArray is a contiguous copy of a ConnectionList with many entries,
+// so that activating them doesn't need to chase the nextConnectionList
+// pointers from one connection to the next. It is only ever appended to.
+// Removing a connection from the list drops the array, and the next
+// activation of the signal builds a new one.
+struct QObjectPrivate::ConnectionArray : public ConnectionOrSignalVector
+{
+    QBasicAtomicInt count;
+    int capacity;
+    // Connection *connections[]
+    Connection **data() { return reinterpret_cast<Connection **>(this + 1); }
+    Connection *const *data() const { return reinterpret_cast<Connection *const *>(this + 1); }
+
+    static ConnectionArray *create(int capacity)
+    {
+        void *ptr = malloc(sizeof(ConnectionArray) + capacity * sizeof(Connection *));
+        Q_CHECK_PTR(ptr);
+        auto array = new (ptr) ConnectionArray;
+        array->next = nullptr;
+        array->count.storeRelaxed(0);
+        array->capacity = capacity;
+        return array;
+    }
+};
+
 struct QObjectPrivate::ConnectionData
 {
     // the id below is used to avoid activating new connections. When the object gets
@@ -142,11 +179,16 @@ struct QObjectPrivate::ConnectionData
             deleteOrphaned(c);
         SignalVector *v = signalVector.loadRelaxed();
         if (v) {
+            for (int i = -1; i < v->count(); ++i)
+                free(v->at(i).flat.loadRelaxed());
             v->~SignalVector();
             free(v);
         }
     }
 
+    // Lists with at least this many connections get a ConnectionArray
+    static constexpr int ConnectionArrayThreshold = 16;
+
     // must be called on the senders connection data
     // assumes the senders and receivers lock are held
     void removeConnection(Connection *c);
@@ -210,6 +252,19 @@ struct QObjectPrivate::ConnectionData
         return signalVector.loadAcquire() ? signalVector.loadRelaxed()->count() : -1;
     }
 
+    // the ConnectionArray functions must be called with the sender's lock held
+    void buildConnectionArray(int signal);
+    void appendToConnectionArray(ConnectionList &list, Connection *c);
+    void dropConnectionArray(ConnectionList &list);
+    void orphanConnectionArray(ConnectionArray *array)
+    {
+        Connection *o = nullptr;
+        do {
+            o = orphaned.loadRelaxed();
+            array->nextInOrphanList = o;
+        } while (!orphaned.testAndSetRelease(o, ConnectionOrSignalVector::fromConnectionArray(array)));
+    }
+
     static void deleteOrphaned(ConnectionOrSignalVector *c);
 };
 
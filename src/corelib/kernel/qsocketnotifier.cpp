@@ -4,6 +4,7 @@
 #define BUILDING_QSOCKETNOTIFIER
 #include "qsocketnotifier.h"
 #undef BUILDING_QSOCKETNOTIFIER
+#include "qsocketnotifier_p.h"
 
 #include "qplatformdefs.h"
 
@@ -25,15 +26,6 @@ Q_LOGGING_CATEGORY(lcSocketNotifierDeprecation, "qt.core.socketnotifier_deprecat
 QT_IMPL_METATYPE_EXTERN_TAGGED(QSocketNotifier::Type, QSocketNotifier_Type)
 QT_IMPL_METATYPE_EXTERN(QSocketDescriptor)
 
-class QSocketNotifierPrivate : public QObjectPrivate
-{
-    Q_DECLARE_PUBLIC(QSocketNotifier)
-public:
-    QSocketDescriptor sockfd;
-    QSocketNotifier::Type sntype;
-    bool snenabled = false;
-};
-
 /*!
     \class QSocketNotifier
     \inmodule QtCore
@@ -167,7 +159,10 @@ QSocketNotifier::QSocketNotifier(qintptr socket, Type type, QObject *parent)
 
 QSocketNotifier::~QSocketNotifier()
 {
+    Q_D(QSocketNotifier);
     setEnabled(false);
+    if (d->group)
+        d->group->removeNotifier(this);
 }
 
 
@@ -321,6 +316,11 @@ bool QSocketNotifier::event(QEvent *e)
         break;
     case QEvent::SockAct:
     case QEvent::SockClose:
+        if (d->group) {
+            // the event dispatcher did not batch this activation
+            d->group->activate({ this });
+            return true;
+        }
         {
             QPointer<QSocketNotifier> alive(this);
             emit activated(d->sockfd, d->sntype, QPrivateSignal());
@@ -335,6 +335,121 @@ bool QSocketNotifier::event(QEvent *e)
     return QObject::event(e);
 }
 
+/*!
+    \internal
+
+    If \a enable is true, the notifier is only activated when its descriptor
+    becomes ready, not again on every iteration of the event loop as long as
+    it stays ready. The receiver must then read or write until the
+    descriptor would block, or it will not be notified again.
+
+    Only the epoll-based QEventDispatcherUNIX supports this, and only if all
+    the notifiers on the descriptor are edge-triggered. With other event
+    dispatchers, the notifier stays level-triggered, which receivers that
+    drain the descriptor handle the same way.
+*/
+void QSocketNotifierPrivate::setEdgeTriggered(bool enable)
+{
+    if (edgeTriggered == enable)
+        return;
+    edgeTriggered = enable;
+    reregister();
+}
+
+/*!
+    \internal
+
+    Registers the notifier with the event dispatcher again, so that the
+    dispatcher picks up changes to its settings.
+*/
+void QSocketNotifierPrivate::reregister()
+{
+    Q_Q(QSocketNotifier);
+    if (!snenabled || !sockfd.isValid())
+        return;
+    auto thisThreadData = threadData.loadRelaxed();
+    if (!thisThreadData->hasEventDispatcher())
+        return;
+    QAbstractEventDispatcher *dispatcher = thisThreadData->eventDispatcher.loadRelaxed();
+    dispatcher->unregisterSocketNotifier(q);
+    dispatcher->registerSocketNotifier(q);
+}
+
+/*!
+    \class QSocketNotifierGroup
+    \inmodule QtCore
+    \internal
+
+    \brief The QSocketNotifierGroup class delivers the activations of
+    several socket notifiers at once.
+
+    The notifiers added to a group no longer emit their activated() signal.
+    Instead, the group emits activated() with the list of its notifiers
+    whose descriptors are ready. QEventDispatcherUNIX batches all the
+    notifiers of a group that are ready after the same poll into a single
+    emission; other event dispatchers deliver one notifier at a time.
+
+    This saves a sendEvent() round trip per notifier for receivers that
+    handle many descriptors. The group must live in the same thread as its
+    notifiers. A slot connected to activated() must not delete any of the
+    notifiers in the list other than the one it is handling; use
+    deleteLater() instead.
+*/
+
+QSocketNotifierGroup::QSocketNotifierGroup(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QSocketNotifierGroup::~QSocketNotifierGroup()
+{
+    for (QSocketNotifier *notifier : std::as_const(members))
+        QSocketNotifierPrivate::get(notifier)->group = nullptr;
+}
+
+/*!
+    \internal
+    Adds \a notifier to this group, removing it from its previous group.
+*/
+void QSocketNotifierGroup::addNotifier(QSocketNotifier *notifier)
+{
+    QSocketNotifierPrivate *d = QSocketNotifierPrivate::get(notifier);
+    if (d->group == this)
+        return;
+    if (Q_UNLIKELY(notifier->thread() != thread())) {
+        qWarning("QSocketNotifierGroup: Cannot add a notifier that lives in another thread");
+        return;
+    }
+    if (d->group)
+        d->group->removeNotifier(notifier);
+    d->group = this;
+    members.append(notifier);
+}
+
+/*!
+    \internal
+    Removes \a notifier from this group. The notifier emits its own
+    activated() signal again.
+*/
+void QSocketNotifierGroup::removeNotifier(QSocketNotifier *notifier)
+{
+    QSocketNotifierPrivate *d = QSocketNotifierPrivate::get(notifier);
+    if (d->group != this)
+        return;
+    d->group = nullptr;
+    members.removeOne(notifier);
+}
+
+/*!
+    \internal
+    Called by the event dispatcher with the notifiers of this group that are
+    \a ready.
+*/
+void QSocketNotifierGroup::activate(const QList<QSocketNotifier *> &ready)
+{
+    emit activated(ready);
+}
+
 /*!
     \class QSocketDescriptor
     \inmodule QtCore
@@ -382,3 +497,4 @@ bool QSocketNotifier::event(QEvent *e)
 QT_END_NAMESPACE
 
 #include "moc_qsocketnotifier.cpp"
+#include "moc_qsocketnotifier_p.cpp"
@@ -0,0 +1,68 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSOCKETNOTIFIER_P_H
+#define QSOCKETNOTIFIER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qsocketnotifier.h"
+#include "QtCore/qlist.h"
+#include "QtCore/private/qobject_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifierGroup;
+
+class Q_CORE_EXPORT QSocketNotifierPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QSocketNotifier)
+public:
+    static QSocketNotifierPrivate *get(QSocketNotifier *n) { return n->d_func(); }
+    static const QSocketNotifierPrivate *get(const QSocketNotifier *n) { return n->d_func(); }
+
+    void setEdgeTriggered(bool enable);
+    void reregister();
+
+    QSocketDescriptor sockfd;
+    QSocketNotifier::Type sntype;
+    bool snenabled = false;
+    // only activate when the descriptor becomes ready, instead of as long
+    // as it is ready; needs support from the event dispatcher
+    bool edgeTriggered = false;
+    QSocketNotifierGroup *group = nullptr;
+};
+
+class Q_CORE_EXPORT QSocketNotifierGroup : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QSocketNotifierGroup(QObject *parent = nullptr);
+    ~QSocketNotifierGroup();
+
+    void addNotifier(QSocketNotifier *notifier);
+    void removeNotifier(QSocketNotifier *notifier);
+    QList<QSocketNotifier *> notifiers() const { return members; }
+
+    void activate(const QList<QSocketNotifier *> &ready);
+
+Q_SIGNALS:
+    void activated(const QList<QSocketNotifier *> &notifiers);
+
+private:
+    Q_DISABLE_COPY(QSocketNotifierGroup)
+    QList<QSocketNotifier *> members;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSOCKETNOTIFIER_P_H
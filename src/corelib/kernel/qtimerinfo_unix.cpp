@@ -4,6 +4,7 @@
 
 #include <qelapsedtimer.h>
 #include <qcoreapplication.h>
+#include <qvarlengtharray.h>
 
 #include "private/qcore_unix_p.h"
 #include "private/qtimerinfo_unix_p.h"
@@ -134,18 +135,146 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+/*
+  The timers are stored in a 4-ary min-heap: the children of the timer at
+  index i are found at indexes 4i+1 to 4i+4. Compared to a binary heap, it is
+  shallower and keeps siblings next to each other, which makes insertion and
+  removal cheaper. Timers with the same timeout are ordered by insertion, so
+  they fire in the same order as they did with a sorted list.
+*/
+static constexpr qsizetype TimerHeapArity = 4;
+
+static inline bool timerFiresBefore(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout != t2->timeout)
+        return t1->timeout < t2->timeout;
+    return t1->sequence < t2->sequence;
+}
+
+void QTimerInfoList::siftUp(qsizetype index)
+{
+    QTimerInfo *ti = at(index);
+    while (index > 0) {
+        const qsizetype parent = (index - 1) / TimerHeapArity;
+        QTimerInfo *p = at(parent);
+        if (!timerFiresBefore(ti, p))
+            break;
+        (*this)[index] = p;
+        p->heapIndex = index;
+        index = parent;
+    }
+    (*this)[index] = ti;
+    ti->heapIndex = index;
+}
+
+void QTimerInfoList::siftDown(qsizetype index)
+{
+    QTimerInfo *ti = at(index);
+    const qsizetype n = size();
+    for (;;) {
+        const qsizetype firstChild = index * TimerHeapArity + 1;
+        if (firstChild >= n)
+            break;
+        const qsizetype lastChild = qMin(firstChild + TimerHeapArity, n);
+        qsizetype best = firstChild;
+        for (qsizetype i = firstChild + 1; i < lastChild; ++i) {
+            if (timerFiresBefore(at(i), at(best)))
+                best = i;
+        }
+        QTimerInfo *c = at(best);
+        if (!timerFiresBefore(c, ti))
+            break;
+        (*this)[index] = c;
+        c->heapIndex = index;
+        index = best;
+    }
+    (*this)[index] = ti;
+    ti->heapIndex = index;
+}
+
 /*
   insert timer info into list
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    ti->sequence = nextSequence++;
+    append(ti);
+    siftUp(size() - 1);
+}
+
+/*
+  remove timer info from list, without deleting it
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    const qsizetype index = ti->heapIndex;
+    Q_ASSERT(at(index) == ti);
+    QTimerInfo *last = takeLast();
+    if (last == ti)
+        return;
+
+    (*this)[index] = last;
+    last->heapIndex = index;
+    if (index > 0 && timerFiresBefore(last, at((index - 1) / TimerHeapArity)))
+        siftUp(index);
+    else
+        siftDown(index);
+}
+
+/*
+  Returns the earliest timer that is not currently being activated. A timer's
+  children can never fire before it, so only the subtrees below timers that
+  are being activated (in recursive event loops) need to be searched.
+*/
+QTimerInfo *QTimerInfoList::firstWaitingTimer() const
+{
+    if (isEmpty())
+        return nullptr;
+
+    QTimerInfo *result = nullptr;
+    QVarLengthArray<qsizetype, 32> pending;
+    pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.last();
+        pending.removeLast();
+        QTimerInfo *t = at(index);
+        if (!t->activateRef) {
+            if (!result || timerFiresBefore(t, result))
+                result = t;
+            continue;
+        }
+        const qsizetype firstChild = index * TimerHeapArity + 1;
+        const qsizetype lastChild = qMin(firstChild + TimerHeapArity, size());
+        for (qsizetype i = firstChild; i < lastChild; ++i)
+            pending.append(i);
     }
-    insert(index+1, ti);
+    return result;
+}
+
+/*
+  Returns the number of timers that have expired at \a currentTime, visiting
+  only those timers and their direct children.
+*/
+int QTimerInfoList::expiredTimerCount(timespec currentTime) const
+{
+    if (isEmpty())
+        return 0;
+
+    int count = 0;
+    QVarLengthArray<qsizetype, 32> pending;
+    pending.append(0);
+    while (!pending.isEmpty()) {
+        const qsizetype index = pending.last();
+        pending.removeLast();
+        if (currentTime < at(index)->timeout)
+            continue;
+        ++count;
+        const qsizetype firstChild = index * TimerHeapArity + 1;
+        const qsizetype lastChild = qMin(firstChild + TimerHeapArity, size());
+        for (qsizetype i = firstChild; i < lastChild; ++i)
+            pending.append(i);
+    }
+    return count;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -356,14 +485,7 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
-
+    QTimerInfo *t = firstWaitingTimer();
     if (!t)
       return false;
 
@@ -390,16 +512,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -461,6 +580,7 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -474,42 +594,48 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    timerRemove(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
+
+    // compact the remaining timers and restore the heap afterwards, instead
+    // of paying for a removal from the heap for each of the object's timers
+    qsizetype kept = 0;
+    for (qsizetype i = 0; i < size(); ++i) {
         QTimerInfo *t = at(i);
         if (t->obj == object) {
             // object found
-            removeAt(i);
+            timersById.remove(t->id);
             if (t == firstTimerInfo)
                 firstTimerInfo = nullptr;
             if (t->activateRef)
                 *(t->activateRef) = nullptr;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            (*this)[kept++] = t;
         }
     }
+    if (kept == size())
+        return true;
+
+    resize(kept);
+    for (qsizetype i = kept; i-- > 0; )
+        siftDown(i);
     return true;
 }
 
@@ -546,11 +672,7 @@ int QTimerInfoList::activateTimers()
 
 
     // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    maxCount = expiredTimerCount(currentTime);
 
     //fire the timers.
     while (maxCount--) {
@@ -572,7 +694,7 @@ int QTimerInfoList::activateTimers()
         }
 
         // remove from list
-        removeFirst();
+        timerRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -20,6 +20,7 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -33,6 +34,8 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    qsizetype heapIndex; // - position in QTimerInfoList
+    quint64 sequence; // - insertion order, breaks ties between equal timeouts
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -41,6 +44,8 @@ struct QTimerInfo {
 #endif
 };
 
+// The list is kept as a 4-ary min-heap ordered by timeout (and insertion
+// order for equal timeouts), so constFirst() is always the next timer to fire.
 class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
@@ -56,6 +61,15 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    QHash<int, QTimerInfo *> timersById;
+    quint64 nextSequence = 0;
+
+    void siftUp(qsizetype index);
+    void siftDown(qsizetype index);
+    void timerRemove(QTimerInfo *);
+    QTimerInfo *firstWaitingTimer() const;
+    int expiredTimerCount(timespec currentTime) const;
+
 public:
     QTimerInfoList();
 
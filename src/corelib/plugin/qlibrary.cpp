@@ -27,6 +27,7 @@
 #include "qelfparser_p.h"
 #include "qfactoryloader_p.h"
 #include "qmachparser_p.h"
+#include "qpluginmetadatacache_p.h"
 
 #include <qtcore_tracepoints_p.h>
 
@@ -207,7 +208,8 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
                 information could not be read.
   Returns  true if version information is present and successfully read.
 */
-static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
+static bool scanPatternUnloaded(const QString &library, QLibraryPrivate *lib,
+                                QPluginMetaDataCache::Entry *cacheEntry)
 {
     QFile file(library);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -249,6 +251,8 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
     QString errMsg = library;
     QLibraryScanResult r = qt_find_pattern(filedata, fdlen, &errMsg);
     if (r.length) {
+        if (cacheEntry)
+            cacheEntry->metaData = QByteArray(filedata + r.pos, r.length);
         if (!lib->metaData.parse(QByteArrayView(filedata + r.pos, r.length))) {
             errMsg = lib->metaData.errorString();
             qCWarning(qt_lcDebugPlugins, "Found invalid metadata in lib %ls: %ls",
@@ -266,9 +270,44 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
 
     lib->errorString = QLibrary::tr("Failed to extract plugin meta data from '%1': %2")
             .arg(library, errMsg);
+    if (cacheEntry) {
+        cacheEntry->metaData.clear();
+        cacheEntry->errorString = lib->errorString;
+    }
     return false;
 }
 
+/*
+  Finds the plugin metadata of \a library, using the metadata cache if it is
+  enabled. Files that could not be read are not cached, as they might be
+  readable the next time.
+*/
+static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
+{
+    QPluginMetaDataCache *cache = QPluginMetaDataCache::instance();
+    if (!cache)
+        return scanPatternUnloaded(library, lib, nullptr);
+
+    QPluginMetaDataCache::Entry entry;
+    if (cache->find(library, &entry)) {
+        if (entry.metaData.isEmpty()) {
+            lib->errorString = entry.errorString;
+            return false;
+        }
+        if (lib->metaData.parse(entry.metaData)) {
+            qCDebug(qt_lcDebugPlugins, "Found cached metadata for lib %ls",
+                    qUtf16Printable(library));
+            return true;
+        }
+        // the cache is corrupt; scan the file again
+    }
+
+    const bool found = scanPatternUnloaded(library, lib, &entry);
+    if (found || !entry.errorString.isEmpty())
+        cache->insert(library, std::move(entry));
+    return found;
+}
+
 static void installCoverageTool(QLibraryPrivate *libPrivate)
 {
 #ifdef __COVERAGESCANNER__
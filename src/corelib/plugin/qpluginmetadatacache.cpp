@@ -0,0 +1,203 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qpluginmetadatacache_p.h"
+
+#include "qcborarray.h"
+#include "qcbormap.h"
+#include "qcborvalue.h"
+#include "qcoreapplication.h"
+#include "qdatetime.h"
+#include "qfile.h"
+#include "qfileinfo.h"
+#include "qloggingcategory.h"
+#if QT_CONFIG(temporaryfile)
+#  include "qsavefile.h"
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+Q_DECLARE_LOGGING_CATEGORY(qt_lcDebugPlugins)
+
+/*!
+    \internal
+    \class QPluginMetaDataCache
+    \inmodule QtCore
+
+    Keeps the plugin metadata found in the files scanned by QLibrary in a
+    file, so that later runs of the application don't need to open and scan
+    every plugin again. The cache is only used if the
+    \c QT_PLUGIN_METADATA_CACHE environment variable names the file to keep
+    it in.
+
+    An entry is only used while the last modification time and the size of
+    the plugin file are unchanged; otherwise, the file is scanned again and
+    the entry replaced. The whole cache is discarded if it was written by a
+    different version of Qt.
+*/
+
+static constexpr int CacheFormatVersion = 1;
+
+struct QPluginMetaDataCacheHolder
+{
+    QPluginMetaDataCacheHolder()
+    {
+        const QString fileName = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+        if (fileName.isEmpty())
+            return;
+        cache.reset(new QPluginMetaDataCache(fileName));
+        // save what the plugin loaders that didn't go through
+        // QFactoryLoader found
+        qAddPostRoutine([] {
+            if (QPluginMetaDataCache *cache = QPluginMetaDataCache::instance())
+                cache->save();
+        });
+    }
+
+    std::unique_ptr<QPluginMetaDataCache> cache;
+};
+
+Q_GLOBAL_STATIC(QPluginMetaDataCacheHolder, pluginMetaDataCacheHolder)
+
+/*!
+    \internal
+    Returns the cache, or \nullptr if the cache is not enabled.
+*/
+QPluginMetaDataCache *QPluginMetaDataCache::instance()
+{
+    QPluginMetaDataCacheHolder *holder = pluginMetaDataCacheHolder();
+    return holder ? holder->cache.get() : nullptr;
+}
+
+QPluginMetaDataCache::QPluginMetaDataCache(const QString &cacheFileName)
+    : cacheFileName(cacheFileName)
+{
+    load();
+}
+
+bool QPluginMetaDataCache::stat(const QString &fileName, Entry *entry)
+{
+    QFileInfo info(fileName);
+    if (!info.exists())
+        return false;
+    entry->lastModified = info.lastModified().toMSecsSinceEpoch();
+    entry->size = info.size();
+    return true;
+}
+
+/*!
+    \internal
+    Looks up the entry for \a fileName and stores it in \a entry. Returns
+    \c false if there is no entry or if the file changed since the entry was
+    made.
+*/
+bool QPluginMetaDataCache::find(const QString &fileName, Entry *entry)
+{
+    Entry current;
+    if (!stat(fileName, &current))
+        return false;
+
+    QMutexLocker locker(&mutex);
+    auto it = entries.constFind(fileName);
+    if (it == entries.constEnd())
+        return false;
+    if (it->lastModified != current.lastModified || it->size != current.size) {
+        qCDebug(qt_lcDebugPlugins, "%ls changed since its metadata was cached",
+                qUtf16Printable(fileName));
+        return false;
+    }
+    *entry = *it;
+    return true;
+}
+
+/*!
+    \internal
+    Stores \a entry for \a fileName, stamped with the current modification
+    time and size of the file.
+*/
+void QPluginMetaDataCache::insert(const QString &fileName, Entry entry)
+{
+    if (!stat(fileName, &entry))
+        return;
+
+    QMutexLocker locker(&mutex);
+    entries.insert(fileName, std::move(entry));
+    dirty = true;
+}
+
+void QPluginMetaDataCache::load()
+{
+    QFile file(cacheFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QCborMap map = QCborValue::fromCbor(file.readAll()).toMap();
+    if (map.value("version"_L1).toInteger() != CacheFormatVersion
+            || map.value("qtVersion"_L1).toInteger() != QT_VERSION) {
+        qCDebug(qt_lcDebugPlugins, "Ignoring the plugin metadata cache %ls from another Qt version",
+                qUtf16Printable(cacheFileName));
+        return;
+    }
+
+    const QCborMap plugins = map.value("plugins"_L1).toMap();
+    entries.reserve(plugins.size());
+    for (auto it : plugins) {
+        const QCborArray a = it.second.toArray();
+        if (!it.first.isString() || a.size() != 3)
+            continue;
+        Entry entry;
+        entry.lastModified = a.at(0).toInteger();
+        entry.size = a.at(1).toInteger(-1);
+        if (a.at(2).isByteArray())
+            entry.metaData = a.at(2).toByteArray();
+        else
+            entry.errorString = a.at(2).toString();
+        entries.insert(it.first.toString(), std::move(entry));
+    }
+    qCDebug(qt_lcDebugPlugins, "Loaded %lld entries from the plugin metadata cache %ls",
+            qint64(entries.size()), qUtf16Printable(cacheFileName));
+}
+
+/*!
+    \internal
+    Writes the cache to disk if any entry was added since it was last saved.
+*/
+void QPluginMetaDataCache::save()
+{
+    QMutexLocker locker(&mutex);
+    if (!dirty)
+        return;
+    dirty = false;
+
+    QCborMap plugins;
+    for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it) {
+        QCborValue data = it->metaData.isEmpty() ? QCborValue(it->errorString)
+                                                 : QCborValue(it->metaData);
+        plugins.insert(it.key(), QCborArray{ it->lastModified, it->size, std::move(data) });
+    }
+    QCborMap map;
+    map.insert("version"_L1, CacheFormatVersion);
+    map.insert("qtVersion"_L1, QT_VERSION);
+    map.insert("plugins"_L1, plugins);
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(cacheFileName);
+#else
+    QFile file(cacheFileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly)
+            || file.write(map.toCborValue().toCbor()) < 0
+#if QT_CONFIG(temporaryfile)
+            || !file.commit()
+#endif
+            ) {
+        qCWarning(qt_lcDebugPlugins, "Could not write the plugin metadata cache %ls: %ls",
+                  qUtf16Printable(cacheFileName), qUtf16Printable(file.errorString()));
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,60 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QPLUGINMETADATACACHE_P_H
+#define QPLUGINMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(library);
+
+QT_BEGIN_NAMESPACE
+
+class QPluginMetaDataCache
+{
+public:
+    struct Entry
+    {
+        qint64 lastModified = 0;    // msecs since epoch
+        qint64 size = -1;
+        QByteArray metaData;        // header and CBOR, as embedded in the file
+        QString errorString;        // set if the file is not a plugin
+    };
+
+    static QPluginMetaDataCache *instance();
+
+    bool find(const QString &fileName, Entry *entry);
+    void insert(const QString &fileName, Entry entry);
+    void save();
+
+private:
+    explicit QPluginMetaDataCache(const QString &cacheFileName);
+    static bool stat(const QString &fileName, Entry *entry);
+    void load();
+
+    QMutex mutex;
+    const QString cacheFileName;
+    QHash<QString, Entry> entries;
+    bool dirty = false;
+
+    friend struct QPluginMetaDataCacheHolder;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLUGINMETADATACACHE_P_H
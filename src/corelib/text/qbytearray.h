@@ -19,6 +19,7 @@
 
 #include <string>
 #include <iterator>
+#include <functional>
 
 #ifndef QT5_NULL_STRINGS
 // Would ideally be off, but in practice breaks too much (Qt 6.0).
@@ -675,4 +676,29 @@ inline QByteArray operator"" _qba(const char *str, size_t size) noexcept
 
 QT_END_NAMESPACE
 
+namespace std {
+// transparent, so that QMap<QByteArray, T> can be searched with a QByteArrayView
+template <>
+struct less<QT_PREPEND_NAMESPACE(QByteArray)>
+{
+    using is_transparent = void;
+
+    bool operator()(const QT_PREPEND_NAMESPACE(QByteArray) &lhs,
+                    const QT_PREPEND_NAMESPACE(QByteArray) &rhs) const noexcept
+    { return lhs < rhs; }
+
+    // templates, so that other arguments are converted to QByteArray as before
+    template <typename View>
+    using if_byte_array_view =
+            std::enable_if_t<std::is_same_v<View, QT_PREPEND_NAMESPACE(QByteArrayView)>, bool>;
+
+    template <typename View, if_byte_array_view<View> = true>
+    bool operator()(const QT_PREPEND_NAMESPACE(QByteArray) &lhs, View rhs) const noexcept
+    { return QT_PREPEND_NAMESPACE(QtPrivate)::compareMemory(lhs, rhs) < 0; }
+    template <typename View, if_byte_array_view<View> = true>
+    bool operator()(View lhs, const QT_PREPEND_NAMESPACE(QByteArray) &rhs) const noexcept
+    { return QT_PREPEND_NAMESPACE(QtPrivate)::compareMemory(lhs, rhs) < 0; }
+};
+} // namespace std
+
 #endif // QBYTEARRAY_H
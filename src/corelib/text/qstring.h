@@ -23,6 +23,7 @@
 
 #include <string>
 #include <iterator>
+#include <functional>
 
 #include <stdarg.h>
 
@@ -1653,6 +1654,33 @@ inline QString operator"" _qs(const char16_t *str, size_t size) noexcept
 
 QT_END_NAMESPACE
 
+namespace std {
+// transparent, so that QMap<QString, T> can be searched with string views
+template <>
+struct less<QT_PREPEND_NAMESPACE(QString)>
+{
+    using is_transparent = void;
+
+    bool operator()(const QT_PREPEND_NAMESPACE(QString) &lhs,
+                    const QT_PREPEND_NAMESPACE(QString) &rhs) const noexcept
+    { return lhs < rhs; }
+
+    // templates, so that other arguments are converted to QString as before
+    template <typename View>
+    using if_string_view = std::enable_if_t<
+            std::disjunction_v<std::is_same<View, QT_PREPEND_NAMESPACE(QStringView)>,
+                               std::is_same<View, QT_PREPEND_NAMESPACE(QLatin1StringView)>>,
+            bool>;
+
+    template <typename View, if_string_view<View> = true>
+    bool operator()(const QT_PREPEND_NAMESPACE(QString) &lhs, View rhs) const noexcept
+    { return QT_PREPEND_NAMESPACE(QtPrivate)::compareStrings(lhs, rhs) < 0; }
+    template <typename View, if_string_view<View> = true>
+    bool operator()(View lhs, const QT_PREPEND_NAMESPACE(QString) &rhs) const noexcept
+    { return QT_PREPEND_NAMESPACE(QtPrivate)::compareStrings(lhs, rhs) < 0; }
+};
+} // namespace std
+
 #if defined(QT_USE_FAST_OPERATOR_PLUS) || defined(QT_USE_QSTRINGBUILDER)
 #include <QtCore/qstringbuilder.h>
 #endif
@@ -0,0 +1,384 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCOROUTINE_H
+#define QCOROUTINE_H
+
+#if 0
+#pragma qt_class(QtCoroutine)
+#endif
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qthread.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
+
+QT_REQUIRE_CONFIG(future);
+
+#if (defined(__cpp_impl_coroutine) && __has_include(<coroutine>)) || defined(Q_CLANG_QDOC)
+#include <coroutine>
+#endif
+
+#if defined(__cpp_lib_coroutine) || defined(Q_CLANG_QDOC)
+
+#ifndef QT_NO_EXCEPTIONS
+#include <exception>
+#endif
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtCoroutine {
+template <typename T = void>
+class Task;
+}
+
+namespace QtPrivate {
+
+// Where a suspended coroutine continues: directly in the thread that
+// resumes it, or through the event loop of the thread that object lives in.
+struct CoroutineContext
+{
+    QPointer<QObject> object;
+    bool isSet = false;
+};
+
+struct CoroutineResumer
+{
+    std::coroutine_handle<> handle;
+    CoroutineContext context;
+
+    void resume()
+    {
+        if (!context.isSet) {
+            handle.resume();
+            return;
+        }
+        // if the object is gone, there's nowhere left to resume the coroutine
+        if (QObject *object = context.object.data()) {
+            QMetaObject::invokeMethod(object, [handle = handle] { handle.resume(); },
+                                      Qt::QueuedConnection);
+        }
+    }
+};
+
+template <typename T>
+class FutureAwaiter
+{
+public:
+    explicit FutureAwaiter(const QFuture<T> &future, const CoroutineContext &context = {})
+        : future(future)
+    {
+        resumer.context = context;
+    }
+
+    bool await_ready() const noexcept { return future.isFinished(); }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        resumer.handle = handle;
+        // Captures nothing but this, so std::function doesn't allocate. The
+        // continuation may run here already, or concurrently in the thread
+        // finishing the future; whoever comes second continues the coroutine.
+        future.d.setContinuation([this](const QFutureInterfaceBase &) {
+            if (state.fetchAndStoreOrdered(Finished) == Suspended)
+                resumer.resume();
+        });
+        return state.fetchAndStoreOrdered(Suspended) != Finished;
+    }
+
+    T await_resume()
+    {
+        if constexpr (std::is_void_v<T>)
+            future.waitForFinished();
+        else if constexpr (std::is_copy_constructible_v<T>)
+            return future.result();
+        else
+            return future.takeResult();
+    }
+
+private:
+    enum { Idle, Suspended, Finished };
+
+    QFuture<T> future;
+    CoroutineResumer resumer;
+    QAtomicInt state = Idle;
+};
+
+class ResumeOnContext
+{
+public:
+    explicit ResumeOnContext(QObject *context) noexcept : context(context) { Q_ASSERT(context); }
+
+    bool await_ready() const noexcept { return context->thread() == QThread::currentThread(); }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        QMetaObject::invokeMethod(context, [handle] { handle.resume(); }, Qt::QueuedConnection);
+    }
+    void await_resume() const noexcept {}
+
+    QObject *context;
+};
+
+#if QT_CONFIG(thread)
+class ResumeOnThreadPool
+{
+public:
+    explicit ResumeOnThreadPool(QThreadPool *pool) noexcept : pool(pool) { Q_ASSERT(pool); }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        pool->start([handle] { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+
+    QThreadPool *pool;
+};
+#endif
+
+template <typename T>
+inline constexpr bool isTaskV = false;
+
+template <typename T>
+inline constexpr bool isTaskV<QtCoroutine::Task<T>> = true;
+
+class TaskPromiseBase
+{
+public:
+    static CoroutineResumer *finishedMarker() noexcept
+    {
+        return reinterpret_cast<CoroutineResumer *>(quintptr(1));
+    }
+
+    struct FinalAwaiter
+    {
+        TaskPromiseBase *promise;
+
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) noexcept
+        {
+            CoroutineResumer *awaiting = promise->awaiting.fetchAndStoreOrdered(finishedMarker());
+            // the promise can be gone once this no longer holds a reference
+            if (!promise->ref.deref()) {
+                self.destroy();
+                return std::noop_coroutine();
+            }
+            if (!awaiting)
+                return std::noop_coroutine();
+            if (!awaiting->context.isSet)
+                return awaiting->handle;
+            awaiting->resume();
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return FinalAwaiter{this}; }
+
+    void unhandled_exception()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        exception = std::current_exception();
+#else
+        qTerminate();
+#endif
+    }
+
+    template <typename Awaitable>
+    decltype(auto) await_transform(Awaitable &&awaitable);
+
+    bool isFinished() const noexcept { return awaiting.loadAcquire() == finishedMarker(); }
+
+    void rethrowPossibleException()
+    {
+#ifndef QT_NO_EXCEPTIONS
+        if (exception)
+            std::rethrow_exception(exception);
+#endif
+    }
+
+    CoroutineContext context;
+    // the Task object and the running coroutine
+    QAtomicInt ref = 2;
+    QAtomicPointer<CoroutineResumer> awaiting;
+#ifndef QT_NO_EXCEPTIONS
+    std::exception_ptr exception;
+#endif
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    QtCoroutine::Task<T> get_return_object() noexcept;
+
+    template <typename U = T>
+    void return_value(U &&value)
+    {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T takeResult()
+    {
+        rethrowPossibleException();
+        Q_ASSERT(result);
+        return std::move(*result);
+    }
+
+private:
+    std::optional<T> result;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    inline QtCoroutine::Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+    void takeResult() { rethrowPossibleException(); }
+};
+
+template <typename T>
+class TaskAwaiter
+{
+public:
+    explicit TaskAwaiter(std::coroutine_handle<TaskPromise<T>> task,
+                         const CoroutineContext &context = {})
+        : task(task)
+    {
+        resumer.context = context;
+    }
+
+    bool await_ready() const noexcept { return task.promise().isFinished(); }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        resumer.handle = handle;
+        // fails if the task finished in the meantime
+        return task.promise().awaiting.testAndSetOrdered(nullptr, &resumer);
+    }
+
+    T await_resume() { return task.promise().takeResult(); }
+
+private:
+    std::coroutine_handle<TaskPromise<T>> task;
+    CoroutineResumer resumer;
+};
+
+template <typename Awaitable>
+decltype(auto) TaskPromiseBase::await_transform(Awaitable &&awaitable)
+{
+    using A = std::remove_cvref_t<Awaitable>;
+    if constexpr (isQFutureV<A>) {
+        return FutureAwaiter(awaitable, context);
+    } else if constexpr (isTaskV<A>) {
+        return TaskAwaiter(awaitable.handle, context);
+    } else if constexpr (std::is_same_v<A, ResumeOnContext>) {
+        context.object = awaitable.context;
+        context.isSet = true;
+        return A(awaitable);
+#if QT_CONFIG(thread)
+    } else if constexpr (std::is_same_v<A, ResumeOnThreadPool>) {
+        context = {};
+        return A(awaitable);
+#endif
+    } else {
+        return std::forward<Awaitable>(awaitable);
+    }
+}
+
+} // namespace QtPrivate
+
+template <typename T>
+QtPrivate::FutureAwaiter<T> operator co_await(const QFuture<T> &future)
+{
+    return QtPrivate::FutureAwaiter<T>(future);
+}
+
+namespace QtCoroutine {
+
+template <typename T>
+class Task
+{
+public:
+    using promise_type = QtPrivate::TaskPromise<T>;
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_MOVE_AND_SWAP(Task)
+    ~Task()
+    {
+        if (handle && !handle.promise().ref.deref())
+            handle.destroy();
+    }
+
+    void swap(Task &other) noexcept { std::swap(handle, other.handle); }
+
+    bool isFinished() const noexcept { return handle && handle.promise().isFinished(); }
+
+    T takeResult()
+    {
+        Q_ASSERT(isFinished());
+        return handle.promise().takeResult();
+    }
+
+    QtPrivate::TaskAwaiter<T> operator co_await() const noexcept
+    {
+        return QtPrivate::TaskAwaiter<T>(handle);
+    }
+
+private:
+    Q_DISABLE_COPY(Task)
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+    friend class QtPrivate::TaskPromise<T>;
+    friend class QtPrivate::TaskPromiseBase;
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+inline QtPrivate::ResumeOnContext resumeOn(QObject *context) noexcept
+{
+    return QtPrivate::ResumeOnContext(context);
+}
+
+#if QT_CONFIG(thread)
+inline QtPrivate::ResumeOnThreadPool resumeOn(QThreadPool *pool) noexcept
+{
+    return QtPrivate::ResumeOnThreadPool(pool);
+}
+#endif
+
+} // namespace QtCoroutine
+
+namespace QtPrivate {
+
+template <typename T>
+QtCoroutine::Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return QtCoroutine::Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+QtCoroutine::Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return QtCoroutine::Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // __cpp_lib_coroutine
+
+#endif // QCOROUTINE_H
@@ -107,6 +107,9 @@ QT_WARNING_POP
     template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
     inline T resultAt(int index) const;
 
+    template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
+    inline const T *contiguousResultsAt(int index, int *count) const;
+
     template<typename U = T, typename = QtPrivate::EnableForNonVoid<U>>
     bool isResultReadyAt(int resultIndex) const { return d.isResultReadyAt(resultIndex); }
 
@@ -291,6 +294,9 @@ private:
 
     friend struct QtPrivate::UnwrapHandler;
 
+    template<typename U>
+    friend class QtPrivate::FutureAwaiter;
+
     using QFuturePrivate =
             std::conditional_t<std::is_same_v<T, void>, QFutureInterfaceBase, QFutureInterface<T>>;
 
@@ -316,6 +322,14 @@ inline T QFuture<T>::resultAt(int index) const
     return d.resultReference(index);
 }
 
+template<typename T>
+template<typename U, typename>
+inline const T *QFuture<T>::contiguousResultsAt(int index, int *count) const
+{
+    d.waitForResult(index);
+    return d.resultPointer(index, count);
+}
+
 template <typename T>
 inline QFuture<T> QFutureInterface<T>::future()
 {
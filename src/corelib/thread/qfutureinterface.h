@@ -38,6 +38,9 @@ class CanceledHandler;
 template<class Function, class ResultType>
 class FailureHandler;
 #endif
+
+template<typename T>
+class FutureAwaiter;
 }
 
 class Q_CORE_EXPORT QFutureInterfaceBase
@@ -179,6 +182,9 @@ private:
     template<class T>
     friend class QPromise;
 
+    template<typename T>
+    friend class QtPrivate::FutureAwaiter;
+
 protected:
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func);
     void setContinuation(std::function<void(const QFutureInterfaceBase &)> func,
@@ -252,6 +258,7 @@ public:
 
     inline const T &resultReference(int index) const;
     inline const T *resultPointer(int index) const;
+    inline const T *resultPointer(int index, int *count) const;
     inline QList<T> results();
 
     T takeResult();
@@ -382,6 +389,15 @@ inline const T *QFutureInterface<T>::resultPointer(int index) const
     return resultStoreBase().resultAt(index).template pointer<T>();
 }
 
+template <typename T>
+inline const T *QFutureInterface<T>::resultPointer(int index, int *count) const
+{
+    Q_ASSERT(!hasException());
+
+    QMutexLocker<QMutex> locker{&mutex()};
+    return resultStoreBase().template contiguousResultsAt<T>(index, count);
+}
+
 template <typename T>
 inline QList<T> QFutureInterface<T>::results()
 {
@@ -394,6 +410,7 @@ inline QList<T> QFutureInterface<T>::results()
 
     QList<T> res;
     QMutexLocker<QMutex> locker{&mutex()};
+    res.reserve(resultStoreBase().count());
 
     QtPrivate::ResultIteratorBase it = resultStoreBase().begin();
     while (it != resultStoreBase().end()) {
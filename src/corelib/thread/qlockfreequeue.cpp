@@ -0,0 +1,319 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qlockfreequeue.h"
+#include "qcoreapplication.h"
+#include "qmutex.h"
+#include "qwaitcondition.h"
+#include "private/qfutex_p.h"
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtFutex;
+
+/*
+    QSpscQueue and QMpmcQueue waiting
+
+    Both queues are ring buffers that never lock. Only threads that want to
+    wait for the queue to change, and receivers of notifications, involve a
+    QtPrivate::LockFreeQueueSignal: there's one for items becoming available
+    and one for space becoming available.
+
+    A thread that waits sets the sleeping flag, then tries the operation
+    again and only goes to sleep on the generation counter if that fails.
+    After every change, the other side checks the flag, and if it's set,
+    clears it, increments the generation and wakes up all sleeping threads;
+    those that still need to wait set the flag again. So only the first
+    change after a thread went to sleep costs a system call. Both
+    sides issue a full fence between their write and their read, so at least
+    one of them is guaranteed to see what the other did: either the waiter
+    sees the change, or the other side sees the waiter.
+
+    Where futexes are available, the generation is the futex. Otherwise the
+    waiters sleep on one of a few wait conditions, chosen by the address of
+    the signal; waking up takes the mutex of the wait condition after
+    incrementing the generation, and sleeping checks it while holding it.
+
+    Notifications work the same: a consumer that finds the queue empty arms
+    the signal and looks once more, and the producer that disarms it again
+    posts the single event.
+*/
+
+namespace {
+struct ParkingSpot
+{
+    QMutex mutex;
+    QWaitCondition condition;
+};
+
+ParkingSpot &parkingSpotFor(const void *address)
+{
+    enum { ParkingSpotCount = 16 };
+    static ParkingSpot spots[ParkingSpotCount];
+    return spots[(quintptr(address) / QtPrivate::LockFreeQueueCacheLineSize) % ParkingSpotCount];
+}
+} // unnamed namespace
+
+void QtPrivate::LockFreeQueueSignal::wakeUpSlow()
+{
+    // only the first change after threads went to sleep needs to wake them
+    if (sleeping.loadRelaxed() && sleeping.fetchAndStoreRelaxed(0)) {
+        generation.fetchAndAddRelease(1);
+        if (futexAvailable()) {
+            futexWakeAll(generation);
+        } else {
+            ParkingSpot &spot = parkingSpotFor(this);
+            QMutexLocker locker(&spot.mutex);
+            spot.condition.wakeAll();
+        }
+    }
+
+    if (armed.loadRelaxed() && armed.testAndSetRelaxed(1, 0)) {
+        if (QObject *object = receiver.loadAcquire())
+            QCoreApplication::postEvent(object, new QEvent(eventType));
+    }
+}
+
+// Returns false if the deadline expired
+bool QtPrivate::LockFreeQueueSignal::sleep(quint32 expected, QDeadlineTimer deadline)
+{
+    if (futexAvailable()) {
+        if (deadline.isForever()) {
+            futexWait(generation, expected);
+            return true;
+        }
+        const qint64 remaining = deadline.remainingTimeNSecs();
+        if (remaining <= 0)
+            return false;
+        return futexWait(generation, expected, remaining);
+    }
+
+    ParkingSpot &spot = parkingSpotFor(this);
+    QMutexLocker locker(&spot.mutex);
+    if (generation.loadRelaxed() != expected)
+        return true;
+    return spot.condition.wait(&spot.mutex, deadline);
+}
+
+/*!
+    \class QSpscQueue
+    \inmodule QtCore
+    \since 6.6
+    \brief The QSpscQueue class is a bounded lock-free queue for passing
+    values from one thread to another.
+
+    \threadsafe
+
+    \ingroup thread
+
+    QSpscQueue is a ring buffer with a capacity fixed at construction. One
+    thread, the producer, pushes values into it, and one other thread, the
+    consumer, pops them in the same order. Neither of them ever locks a
+    mutex, and they only touch shared cache lines when the queue changes
+    between empty, full and neither. For any number of producers and
+    consumers, use QMpmcQueue.
+
+    \note At any time, only one thread may call the functions that push
+    values, and only one thread may call the functions that pop them.
+
+    tryPush() and tryPop() return immediately when the queue is full or
+    empty, respectively. Overloads taking iterators move whole batches of
+    values at once, which costs little more than moving a single one. push()
+    and pop() instead wait for space or values to become available, without
+    spinning, until a deadline expires.
+
+    A consumer that runs an event loop can be notified instead:
+
+    \code
+    static const auto ItemsEvent = QEvent::Type(QEvent::registerEventType());
+
+    void Consumer::start()
+    {
+        queue.setNotificationReceiver(this, ItemsEvent);
+    }
+
+    bool Consumer::event(QEvent *e)
+    {
+        if (e->type() != ItemsEvent)
+            return QObject::event(e);
+        Item items[64];
+        while (qsizetype n = queue.tryPop(items, 64))
+            process(items, n);
+        return true;
+    }
+    \endcode
+
+    The queue posts a single event whenever values are pushed after a pop
+    found it empty, so there is one event per burst of values rather than
+    one per value.
+
+    \sa QMpmcQueue, QSemaphore, QWaitCondition
+*/
+
+/*!
+    \class QMpmcQueue
+    \inmodule QtCore
+    \since 6.6
+    \brief The QMpmcQueue class is a bounded lock-free queue for passing
+    values between any number of threads.
+
+    \threadsafe
+
+    \ingroup thread
+
+    QMpmcQueue has the same interface as QSpscQueue, but any number of
+    threads may push and pop values concurrently. Values pushed by one
+    thread are popped in the order they were pushed in, and a batch pushed
+    with tryPush(first, last) stays together. The queue never locks;
+    threads only retry when another thread changed the same end of the queue
+    at the same time.
+
+    \c T must be nothrow move constructible. To keep the queue consistent
+    when constructing a value throws, values which can't be constructed
+    without exceptions are constructed before they are put into the queue,
+    and moved there.
+
+    \sa QSpscQueue
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::QSpscQueue(qsizetype capacity)
+    \fn template <typename T> QMpmcQueue<T>::QMpmcQueue(qsizetype capacity)
+
+    Constructs an empty queue with space for at least \a capacity values.
+    The capacity is rounded up to the next power of two, and to at least 2
+    for QMpmcQueue. It can't be changed later; memory for all values is
+    allocated here.
+*/
+
+/*!
+    \fn template <typename T> QSpscQueue<T>::~QSpscQueue()
+    \fn template <typename T> QMpmcQueue<T>::~QMpmcQueue()
+
+    Destroys the queue and the values still in it. No thread may use the
+    queue anymore.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::capacity() const
+    \fn template <typename T> qsizetype QMpmcQueue<T>::capacity() const
+
+    Returns how many values the queue can hold.
+*/
+
+/*!
+    \fn template <typename T> qsizetype QSpscQueue<T>::size() const
+    \fn template <typename T> qsizetype QMpmcQueue<T>::size() const
+
+    Returns the number of values in the queue. While other threads use the
+    queue, the result may be outdated as soon as it is returned.
+
+    \sa isEmpty()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::isEmpty() const
+    \fn template <typename T> bool QMpmcQueue<T>::isEmpty() const
+
+    Returns \c true if the queue holds no values; otherwise returns
+    \c false. The same caveat as for size() applies.
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QSpscQueue<T>::tryPush(T &&value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPush(const T &value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPush(T &&value)
+
+    Appends \a value to the queue and returns \c true, unless the queue is
+    full, in which case this function returns \c false without moving from
+    \a value.
+
+    \sa push(), tryEmplace()
+*/
+
+/*!
+    \fn template <typename T> template <typename... Args> bool QSpscQueue<T>::tryEmplace(Args &&...args)
+    \fn template <typename T> template <typename... Args> bool QMpmcQueue<T>::tryEmplace(Args &&...args)
+
+    Appends a value constructed from \a args to the queue and returns
+    \c true, unless the queue is full, in which case this function returns
+    \c false.
+*/
+
+/*!
+    \fn template <typename T> template <typename ForwardIterator, QtPrivate::IfIsForwardIterator<ForwardIterator>> qsizetype QSpscQueue<T>::tryPush(ForwardIterator first, ForwardIterator last)
+    \fn template <typename T> template <typename ForwardIterator, QtPrivate::IfIsForwardIterator<ForwardIterator>> qsizetype QMpmcQueue<T>::tryPush(ForwardIterator first, ForwardIterator last)
+
+    Appends as many values of the range [\a first, \a last) to the queue as
+    fit, and returns their number. Consumers see them become available at
+    once. Use \c std::make_move_iterator() to move the values into the
+    queue.
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::push(const T &value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QSpscQueue<T>::push(T &&value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::push(const T &value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::push(T &&value, QDeadlineTimer deadline)
+
+    Appends \a value to the queue, waiting for space to become available if
+    the queue is full. Returns \c true if the value was appended, or
+    \c false if \a deadline expired before there was space. By default, it
+    waits forever.
+
+    \sa tryPush()
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::tryPop(T *value)
+    \fn template <typename T> bool QMpmcQueue<T>::tryPop(T *value)
+
+    Moves the first value of the queue to \a value, removes it and returns
+    \c true, unless the queue is empty, in which case this function returns
+    \c false.
+
+    \sa pop()
+*/
+
+/*!
+    \fn template <typename T> template <typename OutputIterator> qsizetype QSpscQueue<T>::tryPop(OutputIterator out, qsizetype maxCount)
+    \fn template <typename T> template <typename OutputIterator> qsizetype QMpmcQueue<T>::tryPop(OutputIterator out, qsizetype maxCount)
+
+    Moves up to \a maxCount values from the front of the queue to \a out,
+    removes them, and returns their number. Returns 0 if the queue is
+    empty.
+
+    If assigning to \a out throws, QSpscQueue keeps the value that failed
+    and those after it, while QMpmcQueue drops them.
+*/
+
+/*!
+    \fn template <typename T> bool QSpscQueue<T>::pop(T *value, QDeadlineTimer deadline)
+    \fn template <typename T> bool QMpmcQueue<T>::pop(T *value, QDeadlineTimer deadline)
+
+    Moves the first value of the queue to \a value and removes it, waiting
+    for a value to become available if the queue is empty. Returns \c true
+    if a value was popped, or \c false if \a deadline expired first. By
+    default, it waits forever.
+
+    \sa tryPop()
+*/
+
+/*!
+    \fn template <typename T> void QSpscQueue<T>::setNotificationReceiver(QObject *receiver, QEvent::Type type)
+    \fn template <typename T> void QMpmcQueue<T>::setNotificationReceiver(QObject *receiver, QEvent::Type type)
+
+    Makes the queue post an event of type \a type to \a receiver when
+    values are pushed into the queue while the receiver doesn't know about
+    them yet: the first time after this call, and then whenever values are
+    pushed after a pop found the queue empty. The event wakes up the event
+    loop of the thread \a receiver lives in, and should be handled by
+    popping values until the queue is empty.
+
+    Pass \nullptr to stop the notifications. This function must not be
+    called while values are pushed, and \a receiver must not be destroyed
+    while it's set.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,475 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QLOCKFREEQUEUE_H
+#define QLOCKFREEQUEUE_H
+
+#if 0
+#pragma qt_class(QSpscQueue)
+#pragma qt_class(QMpmcQueue)
+#endif
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcontainertools_impl.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qdeadlinetimer.h>
+
+#include <atomic>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QObject;
+
+namespace QtPrivate {
+
+// keeps what producers and consumers write apart from each other
+constexpr size_t LockFreeQueueCacheLineSize = 64;
+
+// Lets threads wait for a change of a queue, and posts an event to a
+// receiver when the queue changes after a consumer found it empty.
+class Q_CORE_EXPORT LockFreeQueueSignal
+{
+public:
+    // To be called after every change that a waiting thread could be
+    // interested in. The fence orders the change before the check for
+    // waiters; it pairs with the one in wait() and rearm().
+    void wakeUp()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (Q_UNLIKELY(sleeping.loadRelaxed() || armed.loadRelaxed()))
+            wakeUpSlow();
+    }
+
+    // Calls attempt() until it returns true, sleeping in between, or until
+    // deadline expires.
+    template <typename Attempt>
+    bool wait(Attempt &&attempt, QDeadlineTimer deadline)
+    {
+        while (true) {
+            const quint32 current = generation.loadAcquire();
+            sleeping.fetchAndStoreRelaxed(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (attempt())
+                return true;
+            const bool woken = sleep(current, deadline);
+            if (attempt())
+                return true;
+            if (!woken)
+                return false;
+        }
+    }
+
+    // To be called when a consumer found the queue empty. Returns true if
+    // the consumer has to look once more, as an event will only be posted
+    // for changes that happen after that.
+    bool rearm() noexcept
+    {
+        if (Q_LIKELY(!receiver.loadRelaxed()) || armed.loadRelaxed())
+            return false;
+        armed.storeRelaxed(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return true;
+    }
+
+    void setReceiver(QObject *object, QEvent::Type type) noexcept
+    {
+        eventType = type;
+        armed.storeRelaxed(object != nullptr);
+        receiver.storeRelease(object);
+    }
+
+private:
+    void wakeUpSlow();
+    bool sleep(quint32 expected, QDeadlineTimer deadline);
+
+    QAtomicInteger<quint32> generation;
+    // set by threads before they sleep, cleared by the one waking them all
+    QAtomicInt sleeping;
+    QAtomicInt armed;
+    QAtomicPointer<QObject> receiver;
+    QEvent::Type eventType = QEvent::None;
+};
+
+template <typename T>
+struct LockFreeQueueSlot
+{
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *get() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+};
+
+inline quintptr lockFreeQueueMask(qsizetype capacity) noexcept
+{
+    Q_ASSERT_X(capacity > 0, "QSpscQueue/QMpmcQueue", "Capacity must be positive");
+    Q_ASSERT_X(quint64(capacity) <= (quint64(1) << 30), "QSpscQueue/QMpmcQueue",
+               "Capacity too large");
+    // the capacity rounded up to a power of two, minus one
+    const quint64 c = quint64(capacity - 1);
+    return c ? quintptr((quint64(1) << (64 - qCountLeadingZeroBits(c))) - 1) : 0;
+}
+
+} // namespace QtPrivate
+
+template <typename T>
+class QSpscQueue
+{
+    using Slot = QtPrivate::LockFreeQueueSlot<T>;
+    static constexpr size_t CacheLineSize = QtPrivate::LockFreeQueueCacheLineSize;
+
+public:
+    using value_type = T;
+
+    explicit QSpscQueue(qsizetype capacity)
+        : mask(QtPrivate::lockFreeQueueMask(capacity)), buffer(new Slot[mask + 1])
+    {}
+    ~QSpscQueue()
+    {
+        for (quintptr i = head.loadRelaxed(), end = tail.loadRelaxed(); i != end; ++i)
+            buffer[i & mask].get()->~T();
+        delete[] buffer;
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(mask + 1); }
+    qsizetype size() const noexcept
+    {
+        const quintptr h = head.loadAcquire();
+        return qsizetype(qMin(tail.loadAcquire() - h, mask + 1));
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return tryEmplace(value); }
+    bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+
+    template <typename... Args>
+    bool tryEmplace(Args &&...args)
+    {
+        const quintptr t = tail.loadRelaxed();
+        if (!freeSpace(t, 1))
+            return false;
+        new (buffer[t & mask].storage) T(std::forward<Args>(args)...);
+        publish(t + 1);
+        return true;
+    }
+
+    template <typename ForwardIterator, QtPrivate::IfIsForwardIterator<ForwardIterator> = true>
+    qsizetype tryPush(ForwardIterator first, ForwardIterator last)
+    {
+        const quintptr t = tail.loadRelaxed();
+        const qsizetype count = freeSpace(t, qsizetype(std::distance(first, last)));
+        qsizetype i = 0;
+        QT_TRY {
+            for (; i < count; ++i, ++first)
+                new (buffer[(t + i) & mask].storage) T(*first);
+        } QT_CATCH(...) {
+            if (i)
+                publish(t + i);
+            QT_RETHROW;
+        }
+        if (count)
+            publish(t + count);
+        return count;
+    }
+
+    bool push(const T &value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        return tryPush(value)
+                || spaceAvailable.wait([&] { return tryPush(value); }, deadline);
+    }
+    bool push(T &&value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        // tryPush() only moves from value if it succeeds
+        return tryPush(std::move(value))
+                || spaceAvailable.wait([&] { return tryPush(std::move(value)); }, deadline);
+    }
+
+    bool tryPop(T *value)
+    {
+        return tryPop(value, 1) != 0;
+    }
+
+    template <typename OutputIterator>
+    qsizetype tryPop(OutputIterator out, qsizetype maxCount)
+    {
+        const quintptr h = head.loadRelaxed();
+        qsizetype count = available(h, maxCount);
+        if (!count && (!dataAvailable.rearm() || !(count = available(h, maxCount))))
+            return 0;
+        qsizetype i = 0;
+        QT_TRY {
+            for (; i < count; ++i, ++out) {
+                T *item = buffer[(h + i) & mask].get();
+                *out = std::move(*item);
+                item->~T();
+            }
+        } QT_CATCH(...) {
+            // the item that failed is left in the queue
+            if (i)
+                consume(h + i);
+            QT_RETHROW;
+        }
+        consume(h + count);
+        return count;
+    }
+
+    bool pop(T *value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        return tryPop(value)
+                || dataAvailable.wait([&] { return tryPop(value); }, deadline);
+    }
+
+    void setNotificationReceiver(QObject *receiver, QEvent::Type type) noexcept
+    { dataAvailable.setReceiver(receiver, type); }
+
+private:
+    Q_DISABLE_COPY_MOVE(QSpscQueue)
+
+    // The number of slots the producer can fill, up to wanted. Only reads
+    // the index of the consumer if the last known one doesn't suffice.
+    qsizetype freeSpace(quintptr t, qsizetype wanted) noexcept
+    {
+        quintptr free = mask + 1 - (t - cachedHead);
+        if (free < quintptr(wanted)) {
+            cachedHead = head.loadAcquire();
+            free = mask + 1 - (t - cachedHead);
+        }
+        return qMin(qsizetype(free), wanted);
+    }
+
+    qsizetype available(quintptr h, qsizetype wanted) noexcept
+    {
+        quintptr used = cachedTail - h;
+        if (used < quintptr(wanted)) {
+            cachedTail = tail.loadAcquire();
+            used = cachedTail - h;
+        }
+        return qMin(qsizetype(used), wanted);
+    }
+
+    void publish(quintptr newTail)
+    {
+        tail.storeRelease(newTail);
+        dataAvailable.wakeUp();
+    }
+
+    void consume(quintptr newHead)
+    {
+        head.storeRelease(newHead);
+        spaceAvailable.wakeUp();
+    }
+
+    const quintptr mask;
+    Slot * const buffer;
+
+    // written by the consumer
+    alignas(CacheLineSize) QAtomicInteger<quintptr> head;
+    quintptr cachedTail = 0;
+
+    // written by the producer
+    alignas(CacheLineSize) QAtomicInteger<quintptr> tail;
+    quintptr cachedHead = 0;
+
+    alignas(CacheLineSize) QtPrivate::LockFreeQueueSignal dataAvailable;
+    QtPrivate::LockFreeQueueSignal spaceAvailable;
+};
+
+template <typename T>
+class QMpmcQueue
+{
+    using Slot = QtPrivate::LockFreeQueueSlot<T>;
+    static constexpr size_t CacheLineSize = QtPrivate::LockFreeQueueCacheLineSize;
+
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "QMpmcQueue requires a type that can be moved without exceptions");
+
+    // A cell can be filled by the producer that claims position p when its
+    // sequence is p, and emptied by the consumer that claims p once it's p + 1.
+    struct Cell
+    {
+        QAtomicInteger<quintptr> sequence;
+        Slot slot;
+    };
+
+public:
+    using value_type = T;
+
+    // with a single cell, a filled one would look empty for the next round
+    explicit QMpmcQueue(qsizetype capacity)
+        : mask(QtPrivate::lockFreeQueueMask(qMax(capacity, qsizetype(2)))),
+          cells(new Cell[mask + 1])
+    {
+        for (quintptr i = 0; i <= mask; ++i)
+            cells[i].sequence.storeRelaxed(i);
+    }
+    ~QMpmcQueue()
+    {
+        for (quintptr i = head.loadRelaxed(), end = tail.loadRelaxed(); i != end; ++i)
+            cells[i & mask].slot.get()->~T();
+        delete[] cells;
+    }
+
+    qsizetype capacity() const noexcept { return qsizetype(mask + 1); }
+    qsizetype size() const noexcept
+    {
+        const quintptr h = head.loadAcquire();
+        const quintptr t = tail.loadAcquire();
+        // as read, head can be ahead of tail
+        return qsizetype(qptrdiff(t - h) > 0 ? qMin(t - h, mask + 1) : 0);
+    }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool tryPush(const T &value) { return tryEmplace(value); }
+    bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+
+    template <typename... Args>
+    bool tryEmplace(Args &&...args)
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            quintptr pos;
+            if (!claim(tail, 0, 1, &pos))
+                return false;
+            new (cells[pos & mask].slot.storage) T(std::forward<Args>(args)...);
+            cells[pos & mask].sequence.storeRelease(pos + 1);
+            dataAvailable.wakeUp();
+            return true;
+        } else {
+            // a claimed cell has to be filled, so construct it beforehand
+            return tryEmplace(T(std::forward<Args>(args)...));
+        }
+    }
+
+    template <typename ForwardIterator, QtPrivate::IfIsForwardIterator<ForwardIterator> = true>
+    qsizetype tryPush(ForwardIterator first, ForwardIterator last)
+    {
+        using Reference = typename std::iterator_traits<ForwardIterator>::reference;
+        if constexpr (std::is_nothrow_constructible_v<T, Reference>) {
+            quintptr pos;
+            const qsizetype count = claim(tail, 0, qsizetype(std::distance(first, last)), &pos);
+            for (qsizetype i = 0; i < count; ++i, ++first) {
+                Cell &cell = cells[(pos + i) & mask];
+                new (cell.slot.storage) T(*first);
+                cell.sequence.storeRelease(pos + i + 1);
+            }
+            if (count)
+                dataAvailable.wakeUp();
+            return count;
+        } else {
+            qsizetype count = 0;
+            for (; first != last && tryPush(T(*first)); ++first)
+                ++count;
+            return count;
+        }
+    }
+
+    bool push(const T &value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        return tryPush(value)
+                || spaceAvailable.wait([&] { return tryPush(value); }, deadline);
+    }
+    bool push(T &&value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        // tryPush() only moves from value if it succeeds
+        return tryPush(std::move(value))
+                || spaceAvailable.wait([&] { return tryPush(std::move(value)); }, deadline);
+    }
+
+    bool tryPop(T *value)
+    {
+        return tryPop(value, 1) != 0;
+    }
+
+    template <typename OutputIterator>
+    qsizetype tryPop(OutputIterator out, qsizetype maxCount)
+    {
+        quintptr pos;
+        qsizetype count = claim(head, 1, maxCount, &pos);
+        if (!count && (!dataAvailable.rearm() || !(count = claim(head, 1, maxCount, &pos))))
+            return 0;
+        qsizetype i = 0;
+        QT_TRY {
+            for (; i < count; ++i, ++out) {
+                *out = std::move(*cells[(pos + i) & mask].slot.get());
+                release(pos + i);
+            }
+        } QT_CATCH(...) {
+            // claimed cells can't be given back, so the rest is dropped
+            for (; i < count; ++i)
+                release(pos + i);
+            spaceAvailable.wakeUp();
+            QT_RETHROW;
+        }
+        spaceAvailable.wakeUp();
+        return count;
+    }
+
+    bool pop(T *value, QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever))
+    {
+        return tryPop(value)
+                || dataAvailable.wait([&] { return tryPop(value); }, deadline);
+    }
+
+    void setNotificationReceiver(QObject *receiver, QEvent::Type type) noexcept
+    { dataAvailable.setReceiver(receiver, type); }
+
+private:
+    Q_DISABLE_COPY_MOVE(QMpmcQueue)
+
+    // Claims up to wanted consecutive positions from index, which requires
+    // the sequence of their cells to be the position plus offset. Cells stay
+    // in that state until their position is claimed, so checking them before
+    // moving the index is enough.
+    qsizetype claim(QAtomicInteger<quintptr> &index, quintptr offset, qsizetype wanted,
+                    quintptr *pos) noexcept
+    {
+        if (wanted <= 0)
+            return 0;
+        quintptr p = index.loadRelaxed();
+        while (true) {
+            qsizetype count = 0;
+            while (count < wanted
+                   && cells[(p + count) & mask].sequence.loadAcquire() == p + count + offset) {
+                ++count;
+            }
+            if (!count) {
+                const quintptr sequence = cells[p & mask].sequence.loadAcquire();
+                // not yet filled or emptied for this round: full or empty
+                if (qptrdiff(sequence - (p + offset)) < 0)
+                    return 0;
+                // another thread claimed it first
+                p = index.loadRelaxed();
+                continue;
+            }
+            if (index.testAndSetRelaxed(p, p + count, p)) {
+                *pos = p;
+                return count;
+            }
+        }
+    }
+
+    void release(quintptr pos) noexcept
+    {
+        Cell &cell = cells[pos & mask];
+        cell.slot.get()->~T();
+        cell.sequence.storeRelease(pos + mask + 1);
+    }
+
+    const quintptr mask;
+    Cell * const cells;
+
+    alignas(CacheLineSize) QAtomicInteger<quintptr> head;
+    alignas(CacheLineSize) QAtomicInteger<quintptr> tail;
+
+    alignas(CacheLineSize) QtPrivate::LockFreeQueueSignal dataAvailable;
+    QtPrivate::LockFreeQueueSignal spaceAvailable;
+};
+
+QT_END_NAMESPACE
+
+#endif // QLOCKFREEQUEUE_H
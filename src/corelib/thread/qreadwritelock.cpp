@@ -11,7 +11,9 @@
 #include "qwaitcondition.h"
 #include "qreadwritelock_p.h"
 #include "qelapsedtimer.h"
+#include "qdeadlinetimer.h"
 #include "private/qfreelist_p.h"
+#include "private/qfutex_p.h"
 #include "private/qlocking_p.h"
 
 #include <algorithm>
@@ -28,6 +30,16 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * Where futexes are available, non-recursive locks never use a
+ * QReadWriteLockPrivate. Instead, contention is recorded in two more bits of
+ * d_ptr, and the waiting threads sleep on d_ptr itself:
+ *  - 0x4: A thread sleeps, so unlocking must wake the waiting threads.
+ *  - 0x8: A writer waits, so new readers must wait too, and can't starve it.
+ * These bits are only ever set as long as the lock is locked for read or
+ * write, and the unlock that leaves it unlocked clears them. Hence d_ptr
+ * always has one of the two lower bits set while such a lock is locked, and
+ * readers only ever contend on d_ptr, not on a mutex.
  */
 
 namespace {
@@ -38,13 +50,128 @@ enum {
     StateMask = 0x3,
     StateLockedForRead = 0x1,
     StateLockedForWrite = 0x2,
+    StateWaiting = 0x4,
+    StateWriterWaiting = 0x8,
+    StateReaderIncrement = 0x10,
 };
 const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForRead));
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+using namespace QtFutex;
+using StatePointer = QAtomicPointer<QReadWriteLockPrivate>;
+
+inline QReadWriteLockPrivate *toPointer(quintptr state)
+{ return reinterpret_cast<QReadWriteLockPrivate *>(state); }
+
+// true if d_ptr holds a state and no QReadWriteLockPrivate, so that the
+// futex-based implementation applies
+inline bool usesFutex(const QReadWriteLockPrivate *d)
+{ return futexAvailable() && (!d || isUncontendedLocked(d)); }
+
+// Sleeps until d_ptr changes from state, or deadline expires; returns false
+// in the latter case. Like futexes, may return early.
+bool futexWaitUntil(StatePointer &d_ptr, quintptr state, QDeadlineTimer deadline)
+{
+    if (deadline.isForever()) {
+        futexWait(d_ptr, toPointer(state));
+        return true;
+    }
+    const qint64 remaining = deadline.remainingTimeNSecs();
+    if (remaining <= 0)
+        return false;
+    futexWait(d_ptr, toPointer(state), remaining);
+    return true;
 }
 
+bool futexLockForRead(StatePointer &d_ptr, int timeout, QReadWriteLockPrivate *d)
+{
+    const QDeadlineTimer deadline(timeout);
+    quintptr state = quintptr(d);
+    while (true) {
+        if (state == 0) {
+            if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
+                return true;
+        } else if (!(state & (StateLockedForWrite | StateWriterWaiting))) {
+            // locked for read and no writer waits: one more reader
+            Q_ASSERT(state & StateLockedForRead);
+            // the futex only compares the lower 32 bits
+            Q_ASSERT_X(quint32(state + StateReaderIncrement) > StateReaderIncrement,
+                       "QReadWriteLock::tryLockForRead()", "Overflow in lock counter");
+            if (d_ptr.testAndSetAcquire(d, toPointer(state + StateReaderIncrement), d))
+                return true;
+        } else if (timeout == 0) {
+            return false;
+        } else if (!(state & StateWaiting)) {
+            if (d_ptr.testAndSetRelaxed(d, toPointer(state | StateWaiting), d))
+                d = toPointer(state | StateWaiting);
+        } else if (!futexWaitUntil(d_ptr, state, deadline)) {
+            return false;
+        } else {
+            d = d_ptr.loadAcquire();
+        }
+        state = quintptr(d);
+    }
+}
+
+bool futexLockForWrite(StatePointer &d_ptr, int timeout, QReadWriteLockPrivate *d)
+{
+    const QDeadlineTimer deadline(timeout);
+    quintptr state = quintptr(d);
+    while (true) {
+        if (state == 0) {
+            if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
+                return true;
+        } else if (timeout == 0) {
+            return false;
+        } else if ((state & (StateWaiting | StateWriterWaiting))
+                   != (StateWaiting | StateWriterWaiting)) {
+            const quintptr waiting = state | StateWaiting | StateWriterWaiting;
+            if (d_ptr.testAndSetRelaxed(d, toPointer(waiting), d))
+                d = toPointer(waiting);
+        } else if (!futexWaitUntil(d_ptr, state, deadline)) {
+            // Let new readers in again. Other writers that still wait are
+            // woken up as well, and set the bit again.
+            d = d_ptr.loadRelaxed();
+            while (quintptr(d) & StateWriterWaiting) {
+                const quintptr cleared = quintptr(d) & ~quintptr(StateWriterWaiting);
+                if (d_ptr.testAndSetRelaxed(d, toPointer(cleared), d)) {
+                    if (cleared & StateWaiting)
+                        futexWakeAll(d_ptr);
+                    break;
+                }
+            }
+            return false;
+        } else {
+            d = d_ptr.loadAcquire();
+        }
+        state = quintptr(d);
+    }
+}
+
+void futexUnlock(StatePointer &d_ptr, QReadWriteLockPrivate *d)
+{
+    while (true) {
+        const quintptr state = quintptr(d);
+        Q_ASSERT_X(state, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+        if ((state & StateLockedForRead) && state >= StateReaderIncrement) {
+            // other readers remain
+            if (d_ptr.testAndSetRelease(d, toPointer(state - StateReaderIncrement), d))
+                return;
+            continue;
+        }
+        if (!d_ptr.testAndSetRelease(d, nullptr, d))
+            continue;
+        // Wake everyone: there may be readers as well as writers, and the
+        // writers re-assert that they are waiting.
+        if (state & StateWaiting)
+            futexWakeAll(d_ptr);
+        return;
+    }
+}
+} // unnamed namespace
+
 /*! \class QReadWriteLock
     \inmodule QtCore
     \brief The QReadWriteLock class provides read-write locking.
@@ -195,6 +322,9 @@ bool QReadWriteLock::tryLockForRead(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
         return true;
 
+    if (usesFutex(d))
+        return futexLockForRead(d_ptr, timeout, d);
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -309,6 +439,9 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
         return true;
 
+    if (usesFutex(d))
+        return futexLockForWrite(d_ptr, timeout, d);
+
     while (true) {
         if (d == nullptr) {
             if (!d_ptr.testAndSetAcquire(d, dummyLockedForWrite, d))
@@ -362,6 +495,9 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
 void QReadWriteLock::unlock()
 {
     QReadWriteLockPrivate *d = d_ptr.loadAcquire();
+    if (usesFutex(d))
+        return futexUnlock(d_ptr, d);
+
     while (true) {
         Q_ASSERT_X(d, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
 
@@ -114,7 +114,8 @@ bool ResultIteratorBase::isValid() const
 }
 
 ResultStoreBase::ResultStoreBase()
-    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0) { }
+    : insertIndex(0), resultCount(0), m_filterMode(false), filteredResults(0),
+      chunkIndex(-1), chunkCapacity(0) { }
 
 ResultStoreBase::~ResultStoreBase()
 {
@@ -153,6 +154,9 @@ void ResultStoreBase::insertResultItemIfValid(int index, ResultItem &resultItem)
 
 int ResultStoreBase::insertResultItem(int index, ResultItem &resultItem)
 {
+    // whatever comes next doesn't follow the chunk
+    chunkIndex = -1;
+
     int storeIndex;
     if (m_filterMode && index != -1 && index > insertIndex) {
         pendingResults[index] = resultItem;
@@ -212,6 +216,69 @@ int ResultStoreBase::addResults(int index, const void *results, int vectorSize,
     }
 }
 
+/*!
+  \internal
+
+  Returns the chunk that \a _count results added at the insert index can
+  be appended to without reallocating it, or \nullptr if there is none.
+ */
+void *ResultStoreBase::appendableChunk(int _count) const
+{
+    if (chunkIndex == -1 || m_results.isEmpty() || m_results.lastKey() != chunkIndex)
+        return nullptr;
+    const ResultItem &chunk = m_results.last();
+    if (!chunk.isVector() || chunk.count() + _count > chunkCapacity
+            || chunkIndex + chunk.count() != insertIndex - filteredResults) {
+        return nullptr;
+    }
+    return const_cast<void *>(chunk.result);
+}
+
+/*!
+  \internal
+
+  Accounts for \a _count results that were appended to the chunk, and
+  returns the index of the first of them.
+ */
+int ResultStoreBase::appendedToChunk(int _count)
+{
+    m_results.last().m_count += _count;
+    const int index = updateInsertIndex(-1, _count);
+    if (resultCount == index - filteredResults)
+        resultCount += _count;
+    return index;
+}
+
+/*!
+  \internal
+
+  Returns the capacity to reserve for a new chunk, or 0 if the next result
+  should be stored on its own. Futures typically have a single result,
+  which therefore doesn't start a chunk; after that, capacities grow
+  geometrically.
+ */
+int ResultStoreBase::nextChunkCapacity() const
+{
+    enum { MinChunkCapacity = 8, MaxChunkCapacity = 4096 };
+    if (insertIndex == 0)
+        return 0;
+    return chunkCapacity ? qMin(2 * chunkCapacity, int(MaxChunkCapacity)) : int(MinChunkCapacity);
+}
+
+/*!
+  \internal
+
+  Inserts \a chunk, a list holding \a _count results with room for
+  \a capacity of them, so that further results can be appended to it.
+ */
+int ResultStoreBase::addChunk(int index, const void *chunk, int _count, int capacity)
+{
+    const int storeIndex = addResults(index, chunk, _count, _count);
+    chunkIndex = storeIndex - filteredResults;
+    chunkCapacity = capacity;
+    return storeIndex;
+}
+
 ResultIteratorBase ResultStoreBase::begin() const
 {
     return ResultIteratorBase(m_results.begin());
@@ -4,8 +4,10 @@
 #ifndef QTCORE_RESULTSTORE_H
 #define QTCORE_RESULTSTORE_H
 
+#include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
 
+#include <type_traits>
 #include <utility>
 
 QT_REQUIRE_CONFIG(future);
@@ -111,6 +113,31 @@ protected:
     void syncResultCount();
     int updateInsertIndex(int index, int _count);
 
+    // Results added in order are appended to a chunk, a QList whose capacity
+    // is reserved up front, so that its elements never move.
+    bool isInOrder(int index) const
+    { return !m_filterMode && (index == -1 || index == insertIndex); }
+    void *appendableChunk(int _count) const;
+    int appendedToChunk(int _count);
+    int nextChunkCapacity() const;
+    int addChunk(int index, const void *chunk, int _count, int capacity);
+
+    template <typename T, typename U>
+    int appendToChunk(int index, U &&result)
+    {
+        if (void *chunk = appendableChunk(1)) {
+            static_cast<QList<T> *>(chunk)->append(std::forward<U>(result));
+            return appendedToChunk(1);
+        }
+        const int capacity = nextChunkCapacity();
+        if (capacity == 0)
+            return -1;
+        auto chunk = new QList<T>;
+        chunk->reserve(capacity);
+        chunk->append(std::forward<U>(result));
+        return addChunk(index, chunk, 1, capacity);
+    }
+
     QMap<int, ResultItem> m_results;
     int insertIndex;     // The index where the next results(s) will be inserted.
     int resultCount;     // The number of consecutive results stored, starting at index 0.
@@ -119,6 +146,9 @@ protected:
     QMap<int, ResultItem> pendingResults;
     int filteredResults;
 
+    int chunkIndex;      // The key of the chunk in m_results, or -1 if there's none to append to.
+    int chunkCapacity;
+
     template <typename T>
     static void clear(QMap<int, ResultItem> &store)
     {
@@ -137,6 +167,13 @@ public:
     template <typename T>
     int addResult(int index, const T *result)
     {
+        // nothing can be stored at the insert index yet
+        if (result != nullptr && isInOrder(index)) {
+            const int chunkedIndex = appendToChunk<T>(index, *result);
+            if (chunkedIndex != -1)
+                return chunkedIndex;
+        }
+
         if (containsValidResultItem(index)) // reject if already present
             return -1;
 
@@ -149,6 +186,15 @@ public:
     template <typename T>
     int moveResult(int index, T &&result)
     {
+        // QList needs to be able to copy its elements
+        if constexpr (std::is_copy_constructible_v<T>) {
+            if (isInOrder(index)) {
+                const int chunkedIndex = appendToChunk<T>(index, std::move_if_noexcept(result));
+                if (chunkedIndex != -1)
+                    return chunkedIndex;
+            }
+        }
+
         if (containsValidResultItem(index)) // reject if already present
             return -1;
 
@@ -180,6 +226,14 @@ public:
         if (m_filterMode == true && results->count() != totalCount && 0 == results->count())
             return addResults(index, nullptr, 0, totalCount);
 
+        // small batches are copied into the chunk, large ones are shared
+        if (results->count() <= SmallBatchSize && isInOrder(index)) {
+            if (void *chunk = appendableChunk(results->count())) {
+                static_cast<QList<T> *>(chunk)->append(*results);
+                return appendedToChunk(results->count());
+            }
+        }
+
         return addResults(index, new QList<T>(*results), results->count(), totalCount);
     }
 
@@ -209,7 +263,24 @@ public:
         insertIndex = 0;
         ResultStoreBase::clear<T>(pendingResults);
         filteredResults = 0;
+        chunkIndex = -1;
+        chunkCapacity = 0;
     }
+
+    template <typename T>
+    const T *contiguousResultsAt(int index, int *_count) const
+    {
+        const ResultIteratorBase it = resultAt(index);
+        if (it == end()) {
+            *_count = 0;
+            return nullptr;
+        }
+        *_count = it.isVector() ? it.batchSize() - it.vectorIndex() : 1;
+        return it.pointer<T>();
+    }
+
+private:
+    enum { SmallBatchSize = 64 };
 };
 
 } // namespace QtPrivate
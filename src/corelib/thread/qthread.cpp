@@ -40,6 +40,45 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+void QThreadData::takePendingPostedEvents()
+{
+    QPostEventList::PendingEvent *pending = postEventList.pendingEvents.fetchAndStoreAcquire(nullptr);
+    if (!pending)
+        return;
+
+    // the stack holds the most recently posted event first
+    QPostEventList::PendingEvent *reversed = nullptr;
+    while (pending) {
+        QPostEventList::PendingEvent *next = pending->next;
+        pending->next = reversed;
+        reversed = pending;
+        pending = next;
+    }
+
+    while (reversed) {
+        QPostEventList::PendingEvent *current = reversed;
+        reversed = reversed->next;
+
+        QObject *receiver = current->event.receiver;
+        QThreadData *receiverData = QObjectPrivate::get(receiver)->threadData.loadAcquire();
+        if (Q_LIKELY(receiverData == this)) {
+            postEventList.addEvent(current->event);
+            delete current;
+        } else if (receiverData) {
+            // the receiver was moved to another thread after the event was
+            // pushed here; hand it over without taking that thread's mutex
+            receiverData->postEventList.pushPendingEvent(current);
+            if (QAbstractEventDispatcher *dispatcher = receiverData->eventDispatcher.loadAcquire())
+                dispatcher->wakeUp();
+        } else {
+            // the receiver is being destroyed
+            --receiver->d_func()->postedEvents;
+            current->event.event->m_posted = false;
+            delete current->event.event;
+            delete current;
+        }
+    }
+}
 
 /*
   QThreadData
@@ -81,6 +120,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    takePendingPostedEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -42,6 +42,8 @@ public:
     QObject *receiver;
     QEvent *event;
     int priority;
+    // when the event was posted, if QEventDispatchStatistics is enabled
+    qint64 postedAt = 0;
     inline QPostEvent()
         : receiver(nullptr), event(nullptr), priority(0)
     { }
@@ -71,10 +73,31 @@ public:
 
     QMutex mutex;
 
+    // Events that can be posted without locking the mutex (see
+    // QCoreApplication::postEvent()) are pushed onto this stack instead.
+    // Whoever locks the mutex next moves them to the list, in the order they
+    // were posted, with QThreadData::takePendingPostedEvents().
+    struct PendingEvent
+    {
+        QPostEvent event;
+        PendingEvent *next;
+    };
+    QAtomicPointer<PendingEvent> pendingEvents;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
 
+    // thread-safe, does not require the mutex
+    void pushPendingEvent(PendingEvent *pending)
+    {
+        PendingEvent *head = pendingEvents.loadRelaxed();
+        do {
+            pending->next = head;
+        } while (!pendingEvents.testAndSetRelease(head, pending, head));
+    }
+    bool hasPendingEvents() const { return pendingEvents.loadRelaxed() != nullptr; }
+
 private:
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
@@ -216,6 +239,9 @@ public:
 
     static QAbstractEventDispatcher *createEventDispatcher(QThreadData *data);
 
+    static bool setCurrentThreadCpuAffinity(const QList<int> &cpus);
+    static QList<QList<int>> numaNodeCpus();
+
     void ref()
     {
         quitLockRef.ref();
@@ -303,9 +329,12 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasPendingEvents();
     }
 
+    // must be called with postEventList.mutex locked
+    void takePendingPostedEvents();
+
 private:
     QAtomicInt _ref;
 
@@ -34,6 +34,8 @@
 #include <sched.h>
 #include <errno.h>
 
+#include <algorithm>
+
 #if defined(Q_OS_FREEBSD)
 #  include <sys/cpuset.h>
 #elif defined(Q_OS_BSD4)
@@ -482,6 +484,88 @@ int QThread::idealThreadCount() noexcept
     return cores;
 }
 
+#if defined(Q_OS_LINUX)
+// parses the "0-3,8,10-11" format used by the kernel for lists of CPUs and nodes
+static QList<int> parseCpuList(const QByteArray &list)
+{
+    QList<int> result;
+    const QList<QByteArray> ranges = list.trimmed().split(',');
+    for (QByteArrayView range : ranges) {
+        const qsizetype dash = range.indexOf('-');
+        bool ok = true;
+        const int first = range.first(dash < 0 ? range.size() : dash).toInt(&ok);
+        const int last = dash < 0 ? first : (ok ? range.sliced(dash + 1).toInt(&ok) : -1);
+        if (!ok || first < 0 || last < first)
+            return {};
+        for (int i = first; i <= last; ++i)
+            result.append(i);
+    }
+    return result;
+}
+
+static QByteArray readSysFile(const char *fileName)
+{
+    char buffer[4096];
+    int fd = qt_safe_open(fileName, O_RDONLY);
+    if (fd < 0)
+        return {};
+    const qint64 size = qt_safe_read(fd, buffer, sizeof(buffer));
+    qt_safe_close(fd);
+    return size > 0 ? QByteArray(buffer, size) : QByteArray();
+}
+#endif
+
+/*!
+    \internal
+    Restricts the current thread to run on the CPUs with the indexes in
+    \a cpus. Returns \c false if that is not supported or failed.
+*/
+bool QThreadPrivate::setCurrentThreadCpuAffinity(const QList<int> &cpus)
+{
+#if defined(Q_OS_LINUX)
+    if (cpus.isEmpty())
+        return false;
+    const int cpuCount = *std::max_element(cpus.cbegin(), cpus.cend()) + 1;
+    const size_t setSize = CPU_ALLOC_SIZE(cpuCount);
+    QVarLengthArray<cpu_set_t, 1> cpuset((setSize + sizeof(cpu_set_t) - 1) / sizeof(cpu_set_t));
+    CPU_ZERO_S(setSize, cpuset.data());
+    for (int cpu : cpus) {
+        if (cpu >= 0)
+            CPU_SET_S(cpu, setSize, cpuset.data());
+    }
+    if (int error = pthread_setaffinity_np(pthread_self(), setSize, cpuset.data())) {
+        qWarning("QThread: Could not set the CPU affinity of the thread: %ls",
+                 qUtf16Printable(qt_error_string(error)));
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(cpus);
+    return false;
+#endif
+}
+
+/*!
+    \internal
+    Returns the CPUs of each NUMA node of the system, or an empty list if
+    that can't be determined.
+*/
+QList<QList<int>> QThreadPrivate::numaNodeCpus()
+{
+    QList<QList<int>> result;
+#if defined(Q_OS_LINUX)
+    const QList<int> nodes = parseCpuList(readSysFile("/sys/devices/system/node/online"));
+    for (int node : nodes) {
+        const QByteArray fileName = "/sys/devices/system/node/node" + QByteArray::number(node)
+                + "/cpulist";
+        const QList<int> cpus = parseCpuList(readSysFile(fileName.constData()));
+        if (!cpus.isEmpty())
+            result.append(cpus);
+    }
+#endif
+    return result;
+}
+
 void QThread::yieldCurrentThread()
 {
     sched_yield();
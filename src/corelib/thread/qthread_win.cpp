@@ -361,6 +361,43 @@ int QThread::idealThreadCount() noexcept
     return sysinfo.dwNumberOfProcessors;
 }
 
+bool QThreadPrivate::setCurrentThreadCpuAffinity(const QList<int> &cpus)
+{
+    // only the CPUs of the thread's processor group can be used
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < int(sizeof(mask) * 8))
+            mask |= DWORD_PTR(1) << cpu;
+    }
+    if (!mask)
+        return false;
+    if (!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        qErrnoWarning("QThread: Could not set the CPU affinity of the thread");
+        return false;
+    }
+    return true;
+}
+
+QList<QList<int>> QThreadPrivate::numaNodeCpus()
+{
+    QList<QList<int>> result;
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode))
+        return result;
+    for (ULONG node = 0; node <= highestNode && node <= 0xff; ++node) {
+        ULONGLONG mask = 0;
+        if (!GetNumaNodeProcessorMask(UCHAR(node), &mask) || !mask)
+            continue;
+        QList<int> cpus;
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (mask & (ULONGLONG(1) << cpu))
+                cpus.append(cpu);
+        }
+        result.append(cpus);
+    }
+    return result;
+}
+
 void QThread::yieldCurrentThread()
 {
     SwitchToThread();
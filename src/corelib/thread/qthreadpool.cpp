@@ -3,8 +3,10 @@
 
 #include "qthreadpool.h"
 #include "qthreadpool_p.h"
+#include "qthread_p.h"
 #include "qdeadlinetimer.h"
 #include "qcoreapplication.h"
+#include "qscopeguard.h"
 
 #include <algorithm>
 #include <memory>
@@ -24,11 +26,30 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    int localPriority();
+    bool enqueueLocally(QRunnable *runnable, int priority);
+    QRunnable *takeLocalTask(int minimumPriority = INT_MIN);
+    void requeueLocalTasks();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Tasks started from this thread while all threads of the pool are
+    // busy. Kept sorted by priority; this thread runs them without taking
+    // the pool's mutex, idle threads steal them.
+    struct LocalTask
+    {
+        QRunnable *runnable;
+        int priority;
+        qint64 enqueuedAt;
+    };
+    QMutex localMutex;
+    QList<LocalTask> localTasks;
 };
 
+Q_THREAD_LOCAL_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -48,34 +69,45 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
+    if (!manager->cpuAffinity.isEmpty())
+        QThreadPrivate::setCurrentThreadCpuAffinity(manager->cpuAffinity);
     for(;;) {
         QRunnable *r = runnable;
         runnable = nullptr;
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        locker.relock();
+                        requeueLocalTasks();
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // tasks started by r don't need to go through the queue,
+                    // unless there is more important work in it
+                    r = takeLocalTask(manager->queuedPriority.loadRelaxed());
+                } while (r);
                 locker.relock();
             }
 
@@ -84,18 +116,14 @@ void QThreadPoolThread::run()
                 break;
 
             // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            r = manager->takeTask(this);
+            if (!r)
                 break;
-
-            QueuePage *page = manager->queue.first();
-            r = page->pop();
-
-            if (page->isFinished()) {
-                manager->queue.removeFirst();
-                delete page;
-            }
         } while (true);
 
+        // let the remaining threads take over what was started from here
+        requeueLocalTasks();
+
         // this thread is about to be deleted, do not wait or expire
         if (!manager->allThreads.contains(this)) {
             registerThreadInactive();
@@ -110,18 +138,29 @@ void QThreadPoolThread::run()
         }
         manager->waitingThreads.enqueue(this);
         registerThreadInactive();
+        // a busy thread may have queued a task locally before it could see
+        // that this one became idle
+        if (QRunnable *stolen = manager->stealTask(this)) {
+            manager->waitingThreads.removeOne(this);
+            ++manager->activeThreads;
+            manager->updateSaturation();
+            runnable = stolen;
+            continue;
+        }
         // wait for work, exiting after the expiry timeout is reached
         runnableReady.wait(locker.mutex(), QDeadlineTimer(manager->expiryTimeout));
         // this thread is about to be deleted, do not work or expire
         if (!manager->allThreads.contains(this)) {
-            Q_ASSERT(manager->queue.isEmpty());
+            Q_ASSERT(manager->isQueueEmpty());
             return;
         }
         if (manager->waitingThreads.removeOne(this)) {
             manager->expiredThreads.enqueue(this);
+            manager->updateSaturation();
             return;
         }
         ++manager->activeThreads;
+        manager->updateSaturation();
     }
 }
 
@@ -129,6 +168,70 @@ void QThreadPoolThread::registerThreadInactive()
 {
     if (--manager->activeThreads == 0)
         manager->noActiveThreads.wakeAll();
+    manager->updateSaturation();
+}
+
+/*
+    \internal
+    Returns the priority of the most important locally queued task, or
+    INT_MIN if there is none.
+*/
+int QThreadPoolThread::localPriority()
+{
+    QMutexLocker locker(&localMutex);
+    return localTasks.isEmpty() ? INT_MIN : localTasks.first().priority;
+}
+
+/*
+    \internal
+    Queues \a runnable locally, unless there are idle threads that should
+    get it through the pool's queue. Called by this thread only.
+*/
+bool QThreadPoolThread::enqueueLocally(QRunnable *runnable, int priority)
+{
+    // Threads becoming idle clear the flag before they look for tasks to
+    // steal, and they lock localMutex to do so, so either they find this
+    // task or we see that they are idle.
+    QMutexLocker locker(&localMutex);
+    if (!manager->saturated.loadRelaxed())
+        return false;
+    auto it = std::upper_bound(localTasks.cbegin(), localTasks.cend(), priority,
+                               [](int priority, const LocalTask &task) {
+        return task.priority < priority;
+    });
+    localTasks.insert(it, { runnable, priority, QThreadPoolPrivate::timestamp() });
+    return true;
+}
+
+/*
+    \internal
+    Takes the most important locally queued task, if its priority is at
+    least \a minimumPriority. Called by this thread, and by others stealing
+    from it.
+*/
+QRunnable *QThreadPoolThread::takeLocalTask(int minimumPriority)
+{
+    QMutexLocker locker(&localMutex);
+    if (localTasks.isEmpty() || localTasks.first().priority < minimumPriority)
+        return nullptr;
+    const LocalTask task = localTasks.takeFirst();
+    locker.unlock();
+    manager->recordWait(task.enqueuedAt, QThreadPoolPrivate::timestamp());
+    return task.runnable;
+}
+
+/*
+    \internal
+    Moves the locally queued tasks to the queue of the pool, before this
+    thread stops working. Must be called with the pool's mutex locked.
+*/
+void QThreadPoolThread::requeueLocalTasks()
+{
+    QMutexLocker locker(&localMutex);
+    const QList<LocalTask> tasks = std::exchange(localTasks, {});
+    locker.unlock();
+    for (const LocalTask &task : tasks)
+        manager->enqueueTask(task.runnable, task.priority, task.enqueuedAt);
 }
 
 
@@ -141,6 +244,7 @@ QThreadPoolPrivate:: QThreadPoolPrivate()
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
     Q_ASSERT(task != nullptr);
+    const auto updater = qScopeGuard([this] { updateSaturation(); });
     if (allThreads.isEmpty()) {
         // always create at least one thread
         startThread(task);
@@ -185,17 +289,210 @@ inline bool comparePriority(int priority, const QueuePage *p)
     return p->priority() < priority;
 }
 
-void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
+/*!
+    \internal
+    Queues \a runnable with \a priority. \a enqueuedAt is the timestamp()
+    of when it was first queued, or -1 if it is only handed over to an idle
+    thread, so that it isn't counted as waiting.
+*/
+void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority, qint64 enqueuedAt)
 {
     Q_ASSERT(runnable != nullptr);
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
-            page->push(runnable);
+            page->push(runnable, enqueuedAt);
             return;
         }
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
-    queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    queue.insert(std::distance(queue.constBegin(), it),
+                 new QueuePage(runnable, priority, enqueuedAt));
+    queueChanged();
+}
+
+/*!
+    \internal
+    Queues \a runnable to run before all tasks without a deadline, and
+    before those with a \a deadline later than its own.
+*/
+void QThreadPoolPrivate::enqueueDeadlineTask(QRunnable *runnable, qint64 deadline)
+{
+    Q_ASSERT(runnable != nullptr);
+    auto it = std::upper_bound(deadlineQueue.cbegin(), deadlineQueue.cend(), deadline,
+                               [](qint64 deadline, const DeadlineTask &task) {
+        return deadline < task.deadline;
+    });
+    deadlineQueue.insert(it, { runnable, deadline, timestamp() });
+    queueChanged();
+}
+
+/*!
+    \internal
+    Queues \a runnable with the thread of this pool that is starting it, if
+    it is started from one and all threads are busy. The thread runs its
+    locally queued tasks in order of \a priority without taking the mutex,
+    and idle threads steal from it, so that tasks starting more tasks
+    don't all contend for the mutex.
+*/
+bool QThreadPoolPrivate::tryEnqueueLocally(QRunnable *runnable, int priority)
+{
+    QThreadPoolThread *thread = currentPoolThread;
+    if (!thread || thread->manager != this)
+        return false;
+    // aging must see all waiting tasks to be fair
+    if (priorityAgingInterval.loadRelaxed() > 0)
+        return false;
+    return thread->enqueueLocally(runnable, priority);
+}
+
+/*!
+    \internal
+    Takes the next task for \a thread to run: the one with the earliest
+    deadline, or the most important one of the queue and the tasks queued
+    locally with \a thread, or else one stolen from another thread.
+*/
+QRunnable *QThreadPoolPrivate::takeTask(QThreadPoolThread *thread)
+{
+    const qint64 now = timestamp();
+    if (!deadlineQueue.isEmpty())
+        return popDeadlineTask(now);
+    int priority;
+    if (QueuePage *page = nextPage(now, &priority); page && priority > thread->localPriority())
+        return popFrom(page, now);
+    if (QRunnable *r = thread->takeLocalTask())
+        return r;
+    return stealTask(thread);
+}
+
+/*!
+    \internal
+    Returns the page of the queue whose first task should run next, and
+    stores its \a priority, or returns \nullptr if the queue is empty.
+    Without aging, it's the first page. With aging, the time the first task
+    of each page has waited is added to the priority of the page, one for
+    every priorityAgingInterval milliseconds, so that tasks with a low
+    priority run eventually. The pages with the same priority are in the
+    order their tasks were queued in, so their first tasks are the ones
+    that have waited longest.
+*/
+QueuePage *QThreadPoolPrivate::nextPage(qint64 now, int *priority) const
+{
+    if (queue.isEmpty())
+        return nullptr;
+    QueuePage *next = queue.first();
+    *priority = next->priority();
+    const qint64 interval = qint64(priorityAgingInterval.loadRelaxed()) * 1000 * 1000;
+    if (interval <= 0)
+        return next;
+    for (QueuePage *page : queue) {
+        const qint64 enqueuedAt = page->firstEnqueuedAt();
+        const qint64 aging = enqueuedAt < 0 ? 0 : (now - enqueuedAt) / interval;
+        const int aged = int(qMin(page->priority() + aging, qint64(INT_MAX)));
+        if (aged > *priority) {
+            next = page;
+            *priority = aged;
+        }
+    }
+    return next;
+}
+
+/*!
+    \internal
+    Takes the first task of \a page, which is in the queue.
+*/
+QRunnable *QThreadPoolPrivate::popFrom(QueuePage *page, qint64 now)
+{
+    qint64 enqueuedAt;
+    QRunnable *r = page->pop(&enqueuedAt);
+    if (page->isFinished()) {
+        queue.removeOne(page);
+        delete page;
+        queueChanged();
+    }
+    recordWait(enqueuedAt, now);
+    return r;
+}
+
+/*!
+    \internal
+    Takes the task with the earliest deadline.
+*/
+QRunnable *QThreadPoolPrivate::popDeadlineTask(qint64 now)
+{
+    const DeadlineTask task = deadlineQueue.takeFirst();
+    queueChanged();
+    recordWait(task.enqueuedAt, now, task.deadline);
+    return task.runnable;
+}
+
+/*!
+    \internal
+    Takes the most important of the tasks queued locally with the threads
+    other than \a thread.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thread)
+{
+    for (;;) {
+        QThreadPoolThread *victim = nullptr;
+        int victimPriority = INT_MIN;
+        for (QThreadPoolThread *other : qAsConst(allThreads)) {
+            if (other == thread)
+                continue;
+            const int priority = other->localPriority();
+            if (priority > victimPriority) {
+                victim = other;
+                victimPriority = priority;
+            }
+        }
+        if (!victim)
+            return nullptr;
+        // the victim may have run out of tasks in the meantime
+        if (QRunnable *r = victim->takeLocalTask())
+            return r;
+    }
+}
+
+void QThreadPoolPrivate::queueChanged()
+{
+    // tasks with a deadline come before those queued locally, too
+    if (!deadlineQueue.isEmpty())
+        queuedPriority.storeRelaxed(INT_MAX);
+    else
+        queuedPriority.storeRelaxed(queue.isEmpty() ? INT_MIN : queue.first()->priority());
+}
+
+/*!
+    \internal
+    Records that a task queued at \a enqueuedAt, with \a deadline if it's
+    not -1, is taken from its queue at \a now.
+*/
+void QThreadPoolPrivate::recordWait(qint64 enqueuedAt, qint64 now, qint64 deadline)
+{
+    if (enqueuedAt < 0)
+        return;
+    const qint64 wait = qMax(now - enqueuedAt, qint64(0));
+    statistics.queuedTasks.fetchAndAddRelaxed(1);
+    statistics.totalWait.fetchAndAddRelaxed(wait);
+    qint64 maximum = statistics.maximumWait.loadRelaxed();
+    while (wait > maximum && !statistics.maximumWait.testAndSetRelaxed(maximum, wait, maximum))
+        ;
+    if (deadline >= 0 && now > deadline)
+        statistics.missedDeadlines.fetchAndAddRelaxed(1);
+}
+
+/*!
+    \internal
+    Returns the time in nanoseconds on the clock of QDeadlineTimer, which
+    enqueueTask() and recordWait() use.
+*/
+qint64 QThreadPoolPrivate::timestamp() noexcept
+{
+    return QDeadlineTimer::current().deadlineNSecs();
+}
+
+void QThreadPoolPrivate::updateSaturation()
+{
+    saturated.storeRelaxed(waitingThreads.isEmpty() && areAllThreadsActive());
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -209,17 +506,21 @@ int QThreadPoolPrivate::activeThreadCount() const
 void QThreadPoolPrivate::tryToStartMoreThreads()
 {
     // try to push tasks on the queue to any available threads
-    while (!queue.isEmpty()) {
-        QueuePage *page = queue.first();
+    const qint64 now = timestamp();
+    while (!isQueueEmpty()) {
+        if (!deadlineQueue.isEmpty()) {
+            if (!tryStart(deadlineQueue.first().runnable))
+                break;
+            popDeadlineTask(now);
+            continue;
+        }
+
+        int priority;
+        QueuePage *page = nextPage(now, &priority);
         if (!tryStart(page->first()))
             break;
 
-        page->pop();
-
-        if (page->isFinished()) {
-            queue.removeFirst();
-            delete page;
-        }
+        popFrom(page, now);
     }
 }
 
@@ -278,6 +579,7 @@ void QThreadPoolPrivate::reset()
     }
 
     mutex.lock();
+    updateSaturation();
 }
 
 /*!
@@ -287,10 +589,10 @@ void QThreadPoolPrivate::reset()
 */
 bool QThreadPoolPrivate::waitForDone(const QDeadlineTimer &timer)
 {
-    while (!(queue.isEmpty() && activeThreads == 0) && !timer.hasExpired())
+    while (!(isQueueEmpty() && activeThreads == 0) && !timer.hasExpired())
         noActiveThreads.wait(&mutex, timer);
 
-    return queue.isEmpty() && activeThreads == 0;
+    return isQueueEmpty() && activeThreads == 0;
 }
 
 bool QThreadPoolPrivate::waitForDone(int msecs)
@@ -321,6 +623,23 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    const QList<DeadlineTask> deadlineTasks = std::exchange(deadlineQueue, {});
+    queueChanged();
+
+    QList<QThreadPoolThread::LocalTask> localTasks;
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        localTasks += std::exchange(thread->localTasks, {});
+    }
+    locker.unlock();
+    for (const auto &task : qAsConst(localTasks)) {
+        if (task.runnable->autoDelete())
+            delete task.runnable;
+    }
+    for (const DeadlineTask &task : deadlineTasks) {
+        if (task.runnable->autoDelete())
+            delete task.runnable;
+    }
 }
 
 /*!
@@ -353,11 +672,25 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->queueChanged();
             }
             return true;
         }
     }
 
+    auto isDeadlineTask = [runnable](const auto &task) { return task.runnable == runnable; };
+    if (d->deadlineQueue.removeIf(isDeadlineTask)) {
+        d->queueChanged();
+        return true;
+    }
+
+    for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        auto isRunnable = [runnable](const auto &task) { return task.runnable == runnable; };
+        if (thread->localTasks.removeIf(isRunnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -456,7 +789,7 @@ QThreadPool::~QThreadPool()
 {
     Q_D(QThreadPool);
     waitForDone();
-    Q_ASSERT(d->queue.isEmpty());
+    Q_ASSERT(d->isQueueEmpty());
     Q_ASSERT(d->allThreads.isEmpty());
 }
 
@@ -478,7 +811,9 @@ QThreadPool *QThreadPool::globalInstance()
     Reserves a thread and uses it to run \a runnable, unless this thread will
     make the current thread count exceed maxThreadCount().  In that case,
     \a runnable is added to a run queue instead. The \a priority argument can
-    be used to control the run queue's order of execution.
+    be used to control the run queue's order of execution; see
+    priorityAgingInterval for keeping runnables with a low priority from
+    waiting forever.
 
     Note that the thread pool takes ownership of the \a runnable if
     \l{QRunnable::autoDelete()}{runnable->autoDelete()} returns \c true,
@@ -495,10 +830,13 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->tryEnqueueLocally(runnable, priority))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
-        d->enqueueTask(runnable, priority);
+        d->enqueueTask(runnable, priority, QThreadPoolPrivate::timestamp());
 }
 
 /*!
@@ -572,6 +910,54 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
     return false;
 }
 
+/*!
+    \overload
+    \since 6.6
+
+    Reserves a thread and uses it to run \a runnable, unless this thread will
+    make the current thread count exceed maxThreadCount(). In that case,
+    \a runnable is queued to run before all runnables started without a
+    deadline, and before those with a later \a deadline. Use this for
+    latency-critical work. The deadline does not make the pool stop or skip
+    the runnable; queueStatistics() counts the runnables that started after
+    their deadline.
+
+    If \a deadline is \l{QDeadlineTimer::Forever}{forever}, this is the same
+    as start(\a runnable). Ownership of \a runnable is handled the same way
+    as with start().
+
+    \sa queueStatistics()
+*/
+void QThreadPool::start(QRunnable *runnable, QDeadlineTimer deadline)
+{
+    if (!runnable)
+        return;
+    if (deadline.isForever())
+        return start(runnable);
+
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+
+    if (!d->tryStart(runnable))
+        d->enqueueDeadlineTask(runnable, deadline.deadlineNSecs());
+}
+
+/*!
+    \overload
+    \since 6.6
+
+    Reserves a thread and uses it to run \a functionToRun, unless this thread
+    will make the current thread count exceed maxThreadCount(). In that case,
+    \a functionToRun is queued to run before all tasks started without a
+    deadline, and before those with a later \a deadline.
+*/
+void QThreadPool::start(std::function<void()> functionToRun, QDeadlineTimer deadline)
+{
+    if (!functionToRun)
+        return;
+    start(QRunnable::create(std::move(functionToRun)), deadline);
+}
+
 /*! \property QThreadPool::expiryTimeout
     \brief the thread expiry timeout value in milliseconds.
 
@@ -629,6 +1015,7 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
 
     d->requestedMaxThreadCount = maxThreadCount;
     d->tryToStartMoreThreads();
+    d->updateSaturation();
 }
 
 /*! \property QThreadPool::activeThreadCount
@@ -668,6 +1055,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateSaturation();
 }
 
 /*! \property QThreadPool::stackSize
@@ -720,6 +1108,184 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::priorityAgingInterval
+    \brief the time after which a waiting runnable gains one priority level.
+
+    \since 6.6
+
+    Runnables in the queue run in the order of their priority; a steady
+    stream of runnables with a high priority can keep those with a lower
+    one from ever running. When this property is larger than 0, each
+    runnable that has waited in the queue for this many milliseconds is
+    treated as if its priority were one higher, two after twice as long,
+    and so on, so that every runnable runs eventually.
+
+    Runnables started with a deadline still run before all others.
+
+    The default value is 0, which disables aging. When it is enabled,
+    runnables started from threads of the pool always go through the queue
+    of the pool, where aging applies to them, instead of being kept with the
+    thread that started them.
+
+    \sa start()
+*/
+
+int QThreadPool::priorityAgingInterval() const
+{
+    Q_D(const QThreadPool);
+    return d->priorityAgingInterval.loadRelaxed();
+}
+
+void QThreadPool::setPriorityAgingInterval(int msecs)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->priorityAgingInterval.storeRelaxed(qMax(msecs, 0));
+}
+
+/*!
+    \class QThreadPool::QueueStatistics
+    \inmodule QtCore
+    \since 6.6
+    \brief The QueueStatistics struct describes how long runnables waited
+    in the queue of a QThreadPool.
+
+    Only runnables that had to wait because all threads were busy are
+    counted; those that started right away are not.
+
+    \sa QThreadPool::queueStatistics()
+*/
+
+/*!
+    \variable QThreadPool::QueueStatistics::queuedTasks
+
+    The number of runnables taken from the queue to run.
+*/
+
+/*!
+    \variable QThreadPool::QueueStatistics::totalWaitNSecs
+
+    The total time those runnables waited, in nanoseconds. Divided by
+    queuedTasks, this is the mean wait.
+*/
+
+/*!
+    \variable QThreadPool::QueueStatistics::maximumWaitNSecs
+
+    The longest time any runnable waited, in nanoseconds.
+*/
+
+/*!
+    \variable QThreadPool::QueueStatistics::missedDeadlines
+
+    The number of runnables started with a deadline that were taken from
+    the queue after that deadline.
+*/
+
+/*!
+    \since 6.6
+
+    Returns how long the runnables waited in the queue of this pool, since
+    it was created or since resetQueueStatistics() was last called.
+
+    \sa resetQueueStatistics(), start()
+*/
+QThreadPool::QueueStatistics QThreadPool::queueStatistics() const
+{
+    Q_D(const QThreadPool);
+    QueueStatistics result;
+    result.queuedTasks = d->statistics.queuedTasks.loadRelaxed();
+    result.totalWaitNSecs = d->statistics.totalWait.loadRelaxed();
+    result.maximumWaitNSecs = d->statistics.maximumWait.loadRelaxed();
+    result.missedDeadlines = d->statistics.missedDeadlines.loadRelaxed();
+    return result;
+}
+
+/*!
+    \since 6.6
+
+    Resets the statistics returned by queueStatistics().
+*/
+void QThreadPool::resetQueueStatistics()
+{
+    Q_D(QThreadPool);
+    d->statistics.queuedTasks.storeRelaxed(0);
+    d->statistics.totalWait.storeRelaxed(0);
+    d->statistics.maximumWait.storeRelaxed(0);
+    d->statistics.missedDeadlines.storeRelaxed(0);
+}
+
+/*!
+    \since 6.6
+
+    Restricts the threads of the pool to run on the CPUs with the indexes in
+    \a cpus, as the operating system numbers them. An empty list, the
+    default, lets them run on all CPUs the process may use.
+
+    Keeping the threads that work on the same data on the CPUs of one NUMA
+    node, close to the memory they use, avoids costly accesses to the memory
+    of other nodes. See createPoolsPerNumaNode().
+
+    The CPU affinity is only applied when the thread pool starts threads.
+    Changing it does not affect threads that are already running. It is
+    only supported on Linux and Windows, where on Windows it is limited to
+    the first 64 CPUs; on other platforms, it is ignored.
+
+    \sa threadCpuAffinity(), QThread::idealThreadCount()
+*/
+void QThreadPool::setThreadCpuAffinity(const QList<int> &cpus)
+{
+    Q_D(QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    d->cpuAffinity = cpus;
+}
+
+/*!
+    \since 6.6
+
+    Returns the indexes of the CPUs the threads of the pool are restricted
+    to, or an empty list if they are not restricted.
+
+    \sa setThreadCpuAffinity()
+*/
+QList<int> QThreadPool::threadCpuAffinity() const
+{
+    Q_D(const QThreadPool);
+    QMutexLocker locker(&d->mutex);
+    return d->cpuAffinity;
+}
+
+/*!
+    \since 6.6
+
+    Creates one thread pool for each NUMA node of the system, with the given
+    \a parent. The threads of each pool are restricted to the CPUs of its
+    node, and its maxThreadCount() is the number of those CPUs. The pools
+    are returned in the order of the nodes.
+
+    Distributing data-parallel work over these pools by the location of the
+    data lets each thread work on memory of its own node.
+
+    If the NUMA topology can't be determined, or the platform is not
+    supported, a single pool without CPU affinity is returned.
+
+    \sa setThreadCpuAffinity()
+*/
+QList<QThreadPool *> QThreadPool::createPoolsPerNumaNode(QObject *parent)
+{
+    QList<QThreadPool *> pools;
+    const QList<QList<int>> nodes = QThreadPrivate::numaNodeCpus();
+    for (const QList<int> &cpus : nodes) {
+        auto pool = new QThreadPool(parent);
+        pool->setMaxThreadCount(int(cpus.size()));
+        pool->setThreadCpuAffinity(cpus);
+        pools.append(pool);
+    }
+    if (pools.isEmpty())
+        pools.append(new QThreadPool(parent));
+    return pools;
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -738,6 +1304,7 @@ void QThreadPool::releaseThread()
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
     d->tryToStartMoreThreads();
+    d->updateSaturation();
 }
 
 /*!
@@ -772,7 +1339,7 @@ void QThreadPool::startOnReservedThread(QRunnable *runnable)
     if (!d->tryStart(runnable)) {
         // This can only happen if we reserved max threads,
         // and something took the one minimum thread.
-        d->enqueueTask(runnable, INT_MAX);
+        d->enqueueTask(runnable, INT_MAX, QThreadPoolPrivate::timestamp());
     }
 }
 
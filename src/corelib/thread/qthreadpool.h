@@ -8,6 +8,7 @@
 
 #include <QtCore/qthread.h>
 #include <QtCore/qrunnable.h>
+#include <QtCore/qdeadlinetimer.h>
 
 #include <functional>
 
@@ -25,9 +26,19 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
     Q_PROPERTY(QThread::Priority threadPriority READ threadPriority WRITE setThreadPriority)
+    Q_PROPERTY(int priorityAgingInterval READ priorityAgingInterval
+               WRITE setPriorityAgingInterval)
     friend class QFutureInterfaceBase;
 
 public:
+    struct QueueStatistics
+    {
+        qint64 queuedTasks = 0;
+        qint64 totalWaitNSecs = 0;
+        qint64 maximumWaitNSecs = 0;
+        qint64 missedDeadlines = 0;
+    };
+
     QThreadPool(QObject *parent = nullptr);
     ~QThreadPool();
 
@@ -39,6 +50,9 @@ public:
     void start(std::function<void()> functionToRun, int priority = 0);
     bool tryStart(std::function<void()> functionToRun);
 
+    void start(QRunnable *runnable, QDeadlineTimer deadline);
+    void start(std::function<void()> functionToRun, QDeadlineTimer deadline);
+
     void startOnReservedThread(QRunnable *runnable);
     void startOnReservedThread(std::function<void()> functionToRun);
 
@@ -56,6 +70,17 @@ public:
     void setThreadPriority(QThread::Priority priority);
     QThread::Priority threadPriority() const;
 
+    int priorityAgingInterval() const;
+    void setPriorityAgingInterval(int msecs);
+
+    QueueStatistics queueStatistics() const;
+    void resetQueueStatistics();
+
+    void setThreadCpuAffinity(const QList<int> &cpus);
+    QList<int> threadCpuAffinity() const;
+
+    static QList<QThreadPool *> createPoolsPerNumaNode(QObject *parent = nullptr);
+
     void reserveThread();
     void releaseThread();
 
@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <climits>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -37,18 +39,20 @@ public:
         MaxPageSize = 256
     };
 
-    QueuePage(QRunnable *runnable, int pri) : m_priority(pri) { push(runnable); }
+    QueuePage(QRunnable *runnable, int pri, qint64 enqueuedAt) : m_priority(pri)
+    { push(runnable, enqueuedAt); }
 
     bool isFull() { return m_lastIndex >= MaxPageSize - 1; }
 
-    bool isFinished() { return m_firstIndex > m_lastIndex; }
+    bool isFinished() const { return m_firstIndex > m_lastIndex; }
 
-    void push(QRunnable *runnable)
+    void push(QRunnable *runnable, qint64 enqueuedAt)
     {
         Q_ASSERT(runnable != nullptr);
         Q_ASSERT(!isFull());
         m_lastIndex += 1;
         m_entries[m_lastIndex] = runnable;
+        m_enqueuedAt[m_lastIndex] = enqueuedAt;
     }
 
     void skipToNextOrEnd()
@@ -66,11 +70,21 @@ public:
         return runnable;
     }
 
-    QRunnable *pop()
+    // when the first runnable was queued, or -1 if it was only handed over
+    // to an idle thread
+    qint64 firstEnqueuedAt() const
+    {
+        Q_ASSERT(!isFinished());
+        return m_enqueuedAt[m_firstIndex];
+    }
+
+    QRunnable *pop(qint64 *enqueuedAt = nullptr)
     {
         Q_ASSERT(!isFinished());
         QRunnable *runnable = first();
         Q_ASSERT(runnable);
+        if (enqueuedAt)
+            *enqueuedAt = m_enqueuedAt[m_firstIndex];
 
         // clear the entry although this should not be necessary
         m_entries[m_firstIndex] = nullptr;
@@ -105,6 +119,7 @@ private:
     int m_firstIndex = 0;
     int m_lastIndex = -1;
     QRunnable *m_entries[MaxPageSize];
+    qint64 m_enqueuedAt[MaxPageSize];
 };
 
 class QThreadPoolThread;
@@ -117,7 +132,19 @@ public:
     QThreadPoolPrivate();
 
     bool tryStart(QRunnable *task);
-    void enqueueTask(QRunnable *task, int priority = 0);
+    void enqueueTask(QRunnable *task, int priority = 0, qint64 enqueuedAt = -1);
+    void enqueueDeadlineTask(QRunnable *task, qint64 deadline);
+    bool tryEnqueueLocally(QRunnable *task, int priority);
+    QRunnable *takeTask(QThreadPoolThread *thread);
+    QRunnable *stealTask(QThreadPoolThread *thread);
+    QueuePage *nextPage(qint64 now, int *priority) const;
+    QRunnable *popFrom(QueuePage *page, qint64 now);
+    QRunnable *popDeadlineTask(qint64 now);
+    bool isQueueEmpty() const { return queue.isEmpty() && deadlineQueue.isEmpty(); }
+    void queueChanged();
+    void recordWait(qint64 enqueuedAt, qint64 now, qint64 deadline = -1);
+    static qint64 timestamp() noexcept;
+    void updateSaturation();
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -140,14 +167,43 @@ public:
     QQueue<QThreadPoolThread *> expiredThreads;
     QList<QueuePage *> queue;
     QWaitCondition noActiveThreads;
+
+    // tasks started with a deadline, sorted by it; they run before all
+    // tasks in queue
+    struct DeadlineTask
+    {
+        QRunnable *runnable;
+        qint64 deadline;
+        qint64 enqueuedAt;
+    };
+    QList<DeadlineTask> deadlineQueue;
+
+    // Only counts tasks that had to wait in a queue, because all threads
+    // were busy. Updated without the mutex, by threads taking local tasks.
+    struct QueueStatistics
+    {
+        QAtomicInteger<qint64> queuedTasks;
+        QAtomicInteger<qint64> totalWait;           // nanoseconds
+        QAtomicInteger<qint64> maximumWait;         // nanoseconds
+        QAtomicInteger<qint64> missedDeadlines;
+    };
+    QueueStatistics statistics;
+
+    // read without the mutex by the threads of the pool: the priority of
+    // the most important task in the queue, or INT_MIN if it is empty, and
+    // whether all threads are busy so tasks they start stay with them
+    QAtomicInt queuedPriority = INT_MIN;
+    QAtomicInteger<bool> saturated = false;
     QString objectName;
 
     int expiryTimeout = 30000;
+    QAtomicInt priorityAgingInterval = 0;      // read by tryEnqueueLocally() without the mutex
     int requestedMaxThreadCount = QThread::idealThreadCount();  // don't use this directly
     int reservedThreads = 0;
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+    QList<int> cpuAffinity;
 };
 
 QT_END_NAMESPACE
@@ -26,6 +26,8 @@
 #include <qendian.h>
 #include <private/qrandom_p.h>
 #include <private/qsimd_p.h>
+#include <private/qstringconverter_p.h>
+#include <qvarlengtharray.h>
 
 #ifndef QT_BOOTSTRAPPED
 #include <qcoreapplication.h>
@@ -49,6 +51,8 @@
 
 QT_BEGIN_NAMESPACE
 
+void qt_from_latin1(char16_t *dst, const char *str, size_t size) noexcept;
+
 // We assume that pointers and size_t have the same size. If that assumption should fail
 // on a platform the code selecting the different methods below needs to be fixed.
 static_assert(sizeof(size_t) == QT_POINTER_SIZE, "size_t and pointers have different size.");
@@ -982,7 +986,19 @@ size_t qHash(const QBitArray &bitArray, size_t seed) noexcept
 
 size_t qHash(QLatin1StringView key, size_t seed) noexcept
 {
-    return qHashBits(reinterpret_cast<const uchar *>(key.data()), size_t(key.size()), seed);
+    // hash the UTF-16 representation, so that QHash<QString, T> can be
+    // searched with a QLatin1StringView
+    QVarLengthArray<char16_t, 256> buffer(key.size());
+    qt_from_latin1(buffer.data(), key.data(), size_t(key.size()));
+    return qHash(QStringView(buffer.data(), buffer.size()), seed);
+}
+
+size_t qHash(QUtf8StringView key, size_t seed) noexcept
+{
+    // a UTF-8 sequence never has more code units than its UTF-16 equivalent
+    QVarLengthArray<QChar, 256> buffer(key.size());
+    const QChar *end = QUtf8::convertToUnicode(buffer.data(), QByteArrayView(key.data(), key.size()));
+    return qHash(QStringView(buffer.data(), end), seed);
 }
 
 /*!
@@ -1507,6 +1523,40 @@ size_t qHash(long double key, size_t seed) noexcept
     \since 5.0
 
     Returns the hash value for the \a key, using \a seed to seed the calculation.
+
+    Since Qt 6.6, the hash value is the same as that of the QString with
+    the same contents, so that a QHash keyed by QString can be searched
+    with a QLatin1StringView.
+*/
+
+/*!
+    \class QHashHeterogeneousSearch
+    \inmodule QtCore
+    \since 6.6
+    \brief The QHashHeterogeneousSearch trait tells whether a QHash can be
+    searched with another type than its key.
+
+    QHashHeterogeneousSearch<Key, K> derives from \c std::true_type if a
+    QHash, QMultiHash or QSet keyed by \c Key can be searched with a \c K
+    without converting it to \c Key, and from \c std::false_type
+    otherwise. It is true for QString with QStringView, QLatin1StringView
+    and QUtf8StringView, and for QByteArray with QByteArrayView.
+
+    A specialization for other types must come with a qHash() overload for
+    \c K that returns the same value as the one for the equal \c Key, and
+    a qHashEquals() or \c operator==() that compares the two.
+
+    \sa {QHash heterogeneous lookup}
+*/
+
+/*! \fn size_t qHash(QUtf8StringView key, size_t seed = 0)
+    \relates QHash
+    \since 6.6
+
+    Returns the hash value for the \a key, using \a seed to seed the calculation.
+
+    The hash value is the same as that of the QString with the same
+    contents. \a key must contain valid UTF-8.
 */
 
 /*! \fn template <class T> size_t qHash(const T *key, size_t seed = 0)
@@ -1751,6 +1801,19 @@ size_t qHash(long double key, size_t seed) noexcept
     variable \c QT_HASH_SEED to have the value 0. Alternatively, you can call
     the QHashSeed::setDeterministicGlobalSeed() function.
 
+    \target QHash heterogeneous lookup
+    \section2 Heterogeneous lookup
+
+    A QHash whose keys are QString can be searched with a QStringView,
+    QLatin1StringView or QUtf8StringView, and one whose keys are QByteArray
+    with a QByteArrayView, without creating a temporary key. Functions such
+    as find(), contains(), value() and remove() have overloads taking these
+    views. The non-const operator[]() only creates a key when it inserts a
+    new item. The QHashHeterogeneousSearch trait lists the supported
+    combinations.
+
+    \snippet code/src_corelib_tools_qhash.cpp 36
+
     \sa QHashIterator, QMutableHashIterator, QMap, QSet
 */
 
@@ -2021,6 +2084,31 @@ size_t qHash(long double key, size_t seed) noexcept
     \sa count(), QMultiHash::contains()
 */
 
+/*!
+    \fn template <class Key, class T> template <typename K> bool QHash<Key, T>::contains(const K &key) const
+    \fn template <class Key, class T> template <typename K> qsizetype QHash<Key, T>::count(const K &key) const
+    \fn template <class Key, class T> template <typename K> bool QHash<Key, T>::remove(const K &key)
+    \fn template <class Key, class T> template <typename K> T QHash<Key, T>::take(const K &key)
+    \fn template <class Key, class T> template <typename K> T QHash<Key, T>::value(const K &key) const
+    \fn template <class Key, class T> template <typename K> T QHash<Key, T>::value(const K &key, const T &defaultValue) const
+    \fn template <class Key, class T> template <typename K> T &QHash<Key, T>::operator[](const K &key)
+    \fn template <class Key, class T> template <typename K> const T QHash<Key, T>::operator[](const K &key) const
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::iterator QHash<Key, T>::find(const K &key)
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::const_iterator QHash<Key, T>::find(const K &key) const
+    \fn template <class Key, class T> template <typename K> QHash<Key, T>::const_iterator QHash<Key, T>::constFind(const K &key) const
+    \fn template <class Key, class T> template <typename K> QPair<QHash<Key, T>::iterator, QHash<Key, T>::iterator> QHash<Key, T>::equal_range(const K &key)
+    \fn template <class Key, class T> template <typename K> QPair<QHash<Key, T>::const_iterator, QHash<Key, T>::const_iterator> QHash<Key, T>::equal_range(const K &key) const
+    \since 6.6
+    \overload
+
+    These functions look up \a key without converting it to \c Key. They
+    only participate in overload resolution if
+    QHashHeterogeneousSearch<Key, K> is \c true. The non-const operator[]()
+    converts \a key to \c Key only if it inserts a new item.
+
+    \sa {QHash heterogeneous lookup}
+*/
+
 /*! \fn template <class Key, class T> T QHash<Key, T>::value(const Key &key) const
     \fn template <class Key, class T> T QHash<Key, T>::value(const Key &key, const T &defaultValue) const
     \overload
@@ -3128,6 +3216,31 @@ size_t qHash(long double key, size_t seed) noexcept
     \sa operator+=()
 */
 
+/*!
+    \fn template <class Key, class T> template <typename K> bool QMultiHash<Key, T>::contains(const K &key) const
+    \fn template <class Key, class T> template <typename K> qsizetype QMultiHash<Key, T>::count(const K &key) const
+    \fn template <class Key, class T> template <typename K> qsizetype QMultiHash<Key, T>::remove(const K &key)
+    \fn template <class Key, class T> template <typename K> T QMultiHash<Key, T>::take(const K &key)
+    \fn template <class Key, class T> template <typename K> T QMultiHash<Key, T>::value(const K &key) const
+    \fn template <class Key, class T> template <typename K> T QMultiHash<Key, T>::value(const K &key, const T &defaultValue) const
+    \fn template <class Key, class T> template <typename K> QList<T> QMultiHash<Key, T>::values(const K &key) const
+    \fn template <class Key, class T> template <typename K> T &QMultiHash<Key, T>::operator[](const K &key)
+    \fn template <class Key, class T> template <typename K> const T QMultiHash<Key, T>::operator[](const K &key) const
+    \fn template <class Key, class T> template <typename K> QMultiHash<Key, T>::iterator QMultiHash<Key, T>::find(const K &key)
+    \fn template <class Key, class T> template <typename K> QMultiHash<Key, T>::const_iterator QMultiHash<Key, T>::find(const K &key) const
+    \fn template <class Key, class T> template <typename K> QMultiHash<Key, T>::const_iterator QMultiHash<Key, T>::constFind(const K &key) const
+    \fn template <class Key, class T> template <typename K> QPair<QMultiHash<Key, T>::iterator, QMultiHash<Key, T>::iterator> QMultiHash<Key, T>::equal_range(const K &key)
+    \fn template <class Key, class T> template <typename K> QPair<QMultiHash<Key, T>::const_iterator, QMultiHash<Key, T>::const_iterator> QMultiHash<Key, T>::equal_range(const K &key) const
+    \since 6.6
+    \overload
+
+    These functions look up \a key without converting it to \c Key. They
+    only participate in overload resolution if
+    QHashHeterogeneousSearch<Key, K> is \c true.
+
+    \sa {QHash heterogeneous lookup}
+*/
+
 /*!
     \fn template <class Key, class T> bool QMultiHash<Key, T>::contains(const Key &key, const T &value) const
     \since 4.3
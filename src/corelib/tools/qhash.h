@@ -11,6 +11,7 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qmath.h>
 #include <QtCore/qrefcount.h>
+#include <QtCore/qsimd.h>
 
 #include <initializer_list>
 #include <functional> // for std::hash
@@ -223,8 +224,108 @@ struct SpanConstants {
     static constexpr size_t NEntries = (1 << SpanShift);
     static constexpr size_t LocalBucketMask = (NEntries - 1);
     static constexpr size_t UnusedEntry = 0xff;
+    static constexpr size_t GroupSize = 16;
+    static constexpr unsigned char EmptyTag = 0x80;
 
     static_assert ((NEntries & LocalBucketMask) == 0, "NEntries must be a power of two.");
+    static_assert ((NEntries % GroupSize) == 0, "A Span must consist of whole groups.");
+
+    // The bucket index is taken from the lowest bits of the hash, so buckets with the same
+    // index only differ in the higher bits. Fold the highest bits into the tag, so that it
+    // tells those apart, as well as the entries of neighbouring buckets.
+    static constexpr unsigned char tagForHash(size_t hash) noexcept
+    {
+        return static_cast<unsigned char>((hash ^ (hash >> (std::numeric_limits<size_t>::digits - 7))) & 0x7f);
+    }
+};
+
+// A group of GroupSize consecutive tags of a Span, that are compared against a tag at once.
+// The masks returned have one bit set for each slot of the group that matched; on NEON,
+// that's the highest bit of a nibble per slot.
+struct TagGroup {
+#if QT_COMPILER_USES(sse2)
+    using Mask = uint;
+    static constexpr size_t BitsPerSlot = 1;
+
+    explicit TagGroup(const unsigned char *t) noexcept
+        : tags(_mm_loadu_si128(reinterpret_cast<const __m128i *>(t)))
+    {}
+    Mask match(unsigned char tag) const noexcept
+    {
+        return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(char(tag)))));
+    }
+    Mask matchEmpty() const noexcept
+    {
+        return uint(_mm_movemask_epi8(tags));
+    }
+
+private:
+    __m128i tags;
+#elif QT_COMPILER_USES(neon)
+    using Mask = quint64;
+    static constexpr size_t BitsPerSlot = 4;
+
+    explicit TagGroup(const unsigned char *t) noexcept
+        : tags(vld1q_u8(t))
+    {}
+    Mask match(unsigned char tag) const noexcept
+    {
+        return toMask(vceqq_u8(tags, vdupq_n_u8(tag)));
+    }
+    Mask matchEmpty() const noexcept
+    {
+        return toMask(vtstq_u8(tags, vdupq_n_u8(SpanConstants::EmptyTag)));
+    }
+
+private:
+    static Mask toMask(uint8x16_t result) noexcept
+    {
+        // there's no movemask on NEON, but narrowing turns each byte into a nibble
+        const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(result), 4);
+        return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & Q_UINT64_C(0x8888888888888888);
+    }
+
+    uint8x16_t tags;
+#else
+    using Mask = uint;
+    static constexpr size_t BitsPerSlot = 1;
+
+    explicit TagGroup(const unsigned char *t) noexcept
+        : tags(t)
+    {}
+    Mask match(unsigned char tag) const noexcept
+    {
+        Mask mask = 0;
+        for (size_t i = 0; i < SpanConstants::GroupSize; ++i)
+            mask |= Mask(tags[i] == tag) << i;
+        return mask;
+    }
+    Mask matchEmpty() const noexcept
+    {
+        return match(SpanConstants::EmptyTag);
+    }
+
+private:
+    const unsigned char *tags;
+#endif
+
+public:
+    static Mask fromSlot(size_t slot) noexcept
+    {
+        return Mask(~Mask(0) << (slot * BitsPerSlot));
+    }
+    static Mask belowLowest(Mask mask) noexcept
+    {
+        return (mask & (Mask(0) - mask)) - 1;
+    }
+    static Mask clearLowest(Mask mask) noexcept
+    {
+        return mask & (mask - 1);
+    }
+    static size_t lowestSlot(Mask mask) noexcept
+    {
+        return qCountTrailingZeroBits(mask) / BitsPerSlot;
+    }
 };
 
 // Regular hash tables consist of a list of buckets that can store Nodes. But simply allocating one large array of buckets
@@ -235,6 +336,12 @@ struct SpanConstants {
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// Next to the offsets, the tags array holds seven bits of the hash of the Node in each bucket, or
+// EmptyTag for an empty one. Lookups that don't end at the first bucket compare the tags of
+// GroupSize buckets at once, and only compare the keys of the Nodes with a matching tag. Nodes are
+// still stored in the bucket that linear probing yields for them, so this doesn't change the order
+// of iteration.
 template<typename Node>
 struct Span {
     // Entry is a slot available for storing a Node. The Span holds a pointer to
@@ -251,12 +358,14 @@ struct Span {
     };
 
     unsigned char offsets[SpanConstants::NEntries];
+    unsigned char tags[SpanConstants::NEntries];
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
     Span() noexcept
     {
         memset(offsets, SpanConstants::UnusedEntry, sizeof(offsets));
+        memset(tags, SpanConstants::EmptyTag, sizeof(tags));
     }
     ~Span()
     {
@@ -275,7 +384,7 @@ struct Span {
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char tag)
     {
         Q_ASSERT(i < SpanConstants::NEntries);
         Q_ASSERT(offsets[i] == SpanConstants::UnusedEntry);
@@ -285,6 +394,7 @@ struct Span {
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
         offsets[i] = entry;
+        tags[i] = tag;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
@@ -294,6 +404,7 @@ struct Span {
 
         unsigned char entry = offsets[bucket];
         offsets[bucket] = SpanConstants::UnusedEntry;
+        tags[bucket] = SpanConstants::EmptyTag;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -307,6 +418,15 @@ struct Span {
     {
         return (offsets[i] != SpanConstants::UnusedEntry);
     }
+    unsigned char tag(size_t i) const noexcept
+    {
+        return tags[i];
+    }
+    TagGroup group(size_t i) const noexcept
+    {
+        Q_ASSERT(i % SpanConstants::GroupSize == 0);
+        return TagGroup(tags + i);
+    }
     Node &at(size_t i) noexcept
     {
         Q_ASSERT(i < SpanConstants::NEntries);
@@ -339,6 +459,8 @@ struct Span {
         Q_ASSERT(offsets[to] == SpanConstants::UnusedEntry);
         offsets[to] = offsets[from];
         offsets[from] = SpanConstants::UnusedEntry;
+        tags[to] = tags[from];
+        tags[from] = SpanConstants::EmptyTag;
     }
     void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
@@ -350,6 +472,8 @@ struct Span {
             addStorage();
         Q_ASSERT(nextFree < allocated);
         offsets[to] = nextFree;
+        tags[to] = fromSpan.tags[fromIndex];
+        fromSpan.tags[fromIndex] = SpanConstants::EmptyTag;
         Entry &toEntry = entries[nextFree];
         nextFree = toEntry.nextFree();
 
@@ -488,6 +612,12 @@ struct Data
         {
             advance_impl(d, nullptr);
         }
+        void advanceGroupWrapped(const Data *d) noexcept
+        {
+            Q_ASSERT(index % SpanConstants::GroupSize == 0);
+            index += SpanConstants::GroupSize - 1;
+            advance_impl(d, d->spans);
+        }
         bool isUnused() const noexcept
         {
             return !span->hasNode(index);
@@ -504,9 +634,9 @@ struct Data
         {
             return &span->at(index);
         }
-        Node *insert() const
+        Node *insert(unsigned char tag) const
         {
-            return span->insert(index);
+            return span->insert(index, tag);
         }
 
     private:
@@ -547,7 +677,8 @@ struct Data
                 const Node &n = span.at(index);
                 auto it = resized ? findBucket(n.key) : Bucket { spans + s, index };
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                // the seed is the same, so is the tag
+                Node *newNode = it.insert(span.tag(index));
                 new (newNode) Node(n);
             }
         }
@@ -634,7 +765,7 @@ struct Data
                 Node &n = span.at(index);
                 auto it = findBucket(n.key);
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(span.tag(index));
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
@@ -659,67 +790,84 @@ struct Data
         return size >= (numBuckets >> 1);
     }
 
-    Bucket findBucket(const Key &key) const noexcept
+    template <typename K>
+    Bucket findBucket(const K &key) const noexcept
     {
-        Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
-        Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
-        while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return bucket;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return bucket;
-            }
-            bucket.advanceWrapped(this);
-        }
+        return findBucketWithHash(key, QHashPrivate::calculateHash(key, seed));
     }
 
-    Node *findNode(const Key &key) const noexcept
+    template <typename K>
+    Bucket findBucketWithHash(const K &key, size_t hash) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
+        // most lookups end at the first bucket, so check it on its own
+        const size_t offset = bucket.offset();
+        if (offset == SpanConstants::UnusedEntry || qHashEquals(bucket.nodeAtOffset(offset).key, key))
+            return bucket;
+        bucket.advanceWrapped(this);
+        return findBucketInGroups(key, SpanConstants::tagForHash(hash), bucket);
+    }
+
+    template <typename K>
+    Bucket findBucketInGroups(const K &key, unsigned char tag, Bucket bucket) const noexcept
+    {
+        size_t first = bucket.index % SpanConstants::GroupSize;
+        bucket.index -= first;
+        // loop over the groups of buckets until we find the entry we search for
+        // or an empty slot, in which case we know the entry doesn't exist. Only
+        // the entries before the first empty slot are part of the probe sequence.
         while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return nullptr;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return &n;
+            const TagGroup group = bucket.span->group(bucket.index);
+            const TagGroup::Mask probed = TagGroup::fromSlot(first);
+            const TagGroup::Mask empty = group.matchEmpty() & probed;
+            TagGroup::Mask matches = group.match(tag) & probed;
+            if (empty)
+                matches &= TagGroup::belowLowest(empty);
+            for (; matches; matches = TagGroup::clearLowest(matches)) {
+                Bucket candidate(bucket.span, bucket.index + TagGroup::lowestSlot(matches));
+                if (qHashEquals(candidate.nodeAtOffset(candidate.offset()).key, key))
+                    return candidate;
             }
-            bucket.advanceWrapped(this);
+            if (empty)
+                return Bucket(bucket.span, bucket.index + TagGroup::lowestSlot(empty));
+            first = 0;
+            bucket.advanceGroupWrapped(this);
         }
     }
 
+    template <typename K>
+    Node *findNode(const K &key) const noexcept
+    {
+        Bucket bucket = findBucket(key);
+        if (bucket.isUnused())
+            return nullptr;
+        return bucket.node();
+    }
+
     struct InsertionResult
     {
         iterator it;
         bool initialized;
     };
 
-    InsertionResult findOrInsert(const Key &key) noexcept
+    template <typename K>
+    InsertionResult findOrInsert(const K &key) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
         if (numBuckets > 0) {
-            it = findBucket(key);
+            it = findBucketWithHash(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            it = findBucketWithHash(key, hash); // need to get a new iterator after rehashing
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
-        it.insert();
+        it.insert(SpanConstants::tagForHash(hash));
         ++size;
         return { it.toIterator(this), false };
     }
@@ -948,6 +1096,11 @@ public:
     }
 
     bool remove(const Key &key)
+    {
+        return removeImpl(key);
+    }
+private:
+    template <typename K> bool removeImpl(const K &key)
     {
         if (isEmpty()) // prevents detaching shared null
             return false;
@@ -961,12 +1114,19 @@ public:
         d->erase(it);
         return true;
     }
+
+public:
     template <typename Predicate>
     qsizetype removeIf(Predicate pred)
     {
         return QtPrivate::associative_erase_if(*this, pred);
     }
     T take(const Key &key)
+    {
+        return takeImpl(key);
+    }
+private:
+    template <typename K> T takeImpl(const K &key)
     {
         if (isEmpty()) // prevents detaching shared null
             return T();
@@ -982,6 +1142,7 @@ public:
         return value;
     }
 
+public:
     bool contains(const Key &key) const noexcept
     {
         if (!d)
@@ -1025,7 +1186,7 @@ public:
     }
 
 private:
-    T *valueImpl(const Key &key) const noexcept
+    template <typename K> T *valueImpl(const K &key) const noexcept
     {
         if (d) {
             Node *n = d->findNode(key);
@@ -1052,16 +1213,27 @@ public:
     }
 
     T &operator[](const Key &key)
+    {
+        return operatorIndexImpl(key);
+    }
+private:
+    template <typename K> T &operatorIndexImpl(const K &key)
     {
         const auto copy = isDetached() ? QHash() : *this; // keep 'key' alive across the detach
         detach();
         auto result = d->findOrInsert(key);
         Q_ASSERT(!result.it.atEnd());
-        if (!result.initialized)
-            Node::createInPlace(result.it.node(), key, T());
+        if (!result.initialized) {
+            if constexpr (std::is_same_v<K, Key>)
+                Node::createInPlace(result.it.node(), key, T());
+            else
+                Node::createInPlace(result.it.node(), QHashPrivate::heterogeneousKey<Key>(key), T());
+        }
         return result.it.node()->value;
     }
 
+public:
+
     const T operator[](const Key &key) const noexcept
     {
         return value(key);
@@ -1230,26 +1402,41 @@ public:
 
     QPair<iterator, iterator> equal_range(const Key &key)
     {
-        auto first = find(key);
-        auto second = first;
-        if (second != iterator())
-            ++second;
-        return qMakePair(first, second);
+        return equal_range_impl(*this, key);
     }
-
     QPair<const_iterator, const_iterator> equal_range(const Key &key) const noexcept
     {
-        auto first = find(key);
+        return equal_range_impl(*this, key);
+    }
+private:
+    template <typename Hash, typename K> static auto equal_range_impl(Hash &self, const K &key)
+    {
+        auto first = self.find(key);
         auto second = first;
-        if (second != iterator())
+        if (second != decltype(first){})
             ++second;
         return qMakePair(first, second);
     }
 
+public:
+
     typedef iterator Iterator;
     typedef const_iterator ConstIterator;
     inline qsizetype count() const noexcept { return d ? qsizetype(d->size) : 0; }
     iterator find(const Key &key)
+    {
+        return findImpl(key);
+    }
+    const_iterator find(const Key &key) const noexcept
+    {
+        return constFindImpl(key);
+    }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        return find(key);
+    }
+private:
+    template <typename K> iterator findImpl(const K &key)
     {
         if (isEmpty()) // prevents detaching shared null
             return end();
@@ -1261,7 +1448,7 @@ public:
             return end();
         return iterator(it.toIterator(d));
     }
-    const_iterator find(const Key &key) const noexcept
+    template <typename K> const_iterator constFindImpl(const K &key) const noexcept
     {
         if (isEmpty())
             return end();
@@ -1270,10 +1457,8 @@ public:
             return end();
         return const_iterator({d, it.toBucketIndex(d)});
     }
-    const_iterator constFind(const Key &key) const noexcept
-    {
-        return find(key);
-    }
+
+public:
     iterator insert(const Key &key, const T &value)
     {
         return emplace(key, value);
@@ -1322,6 +1507,81 @@ public:
 
     inline bool empty() const noexcept { return isEmpty(); }
 
+    template <typename K>
+    using if_heterogeneously_searchable = QHashPrivate::if_heterogeneously_searchable_with<Key, K>;
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool remove(const K &key)
+    {
+        return removeImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T take(const K &key)
+    {
+        return takeImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        return d ? d->findNode(key) != nullptr : false;
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    qsizetype count(const K &key) const noexcept
+    {
+        return contains(key) ? 1 : 0;
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T value(const K &key) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return T();
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T value(const K &key, const T &defaultValue) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return defaultValue;
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T &operator[](const K &key)
+    {
+        return operatorIndexImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const T operator[](const K &key) const noexcept
+    {
+        return value(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    QPair<iterator, iterator> equal_range(const K &key)
+    {
+        return equal_range_impl(*this, key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    QPair<const_iterator, const_iterator> equal_range(const K &key) const noexcept
+    {
+        return equal_range_impl(*this, key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator find(const K &key)
+    {
+        return findImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        return constFindImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        return find(key);
+    }
+
 private:
     template <typename ...Args>
     iterator emplace_helper(Key &&key, Args &&... args)
@@ -1511,6 +1771,11 @@ public:
     }
 
     qsizetype remove(const Key &key)
+    {
+        return removeImpl(key);
+    }
+private:
+    template <typename K> qsizetype removeImpl(const K &key)
     {
         if (isEmpty()) // prevents detaching shared null
             return 0;
@@ -1527,12 +1792,19 @@ public:
         d->erase(it);
         return n;
     }
+
+public:
     template <typename Predicate>
     qsizetype removeIf(Predicate pred)
     {
         return QtPrivate::associative_erase_if(*this, pred);
     }
     T take(const Key &key)
+    {
+        return takeImpl(key);
+    }
+private:
+    template <typename K> T takeImpl(const K &key)
     {
         if (isEmpty()) // prevents detaching shared null
             return T();
@@ -1558,6 +1830,7 @@ public:
         return t;
     }
 
+public:
     bool contains(const Key &key) const noexcept
     {
         if (!d)
@@ -1597,7 +1870,7 @@ public:
     }
 
 private:
-    T *valueImpl(const Key &key) const noexcept
+    template <typename K> T *valueImpl(const K &key) const noexcept
     {
         if (d) {
             Node *n = d->findNode(key);
@@ -1625,16 +1898,28 @@ public:
     }
 
     T &operator[](const Key &key)
+    {
+        return operatorIndexImpl(key);
+    }
+private:
+    template <typename K> T &operatorIndexImpl(const K &key)
     {
         const auto copy = isDetached() ? QMultiHash() : *this; // keep 'key' alive across the detach
         detach();
         auto result = d->findOrInsert(key);
         Q_ASSERT(!result.it.atEnd());
-        if (!result.initialized)
-            Node::createInPlace(result.it.node(), key, T());
+        if (!result.initialized) {
+            if constexpr (std::is_same_v<K, Key>)
+                Node::createInPlace(result.it.node(), key, T());
+            else
+                Node::createInPlace(result.it.node(), QHashPrivate::heterogeneousKey<Key>(key), T());
+            ++m_size;
+        }
         return result.it.node()->value->value;
     }
 
+public:
+
     const T operator[](const Key &key) const noexcept
     {
         return value(key);
@@ -1667,6 +1952,11 @@ public:
     }
     QList<T> values() const { return QList<T>(begin(), end()); }
     QList<T> values(const Key &key) const
+    {
+        return valuesImpl(key);
+    }
+private:
+    template <typename K> QList<T> valuesImpl(const K &key) const
     {
         QList<T> values;
         if (d) {
@@ -1682,6 +1972,8 @@ public:
         return values;
     }
 
+public:
+
     class const_iterator;
 
     class iterator
@@ -1894,6 +2186,19 @@ public:
     typedef const_iterator ConstIterator;
     inline qsizetype count() const noexcept { return size(); }
     iterator find(const Key &key)
+    {
+        return findImpl(key);
+    }
+    const_iterator find(const Key &key) const noexcept
+    {
+        return constFind(key);
+    }
+    const_iterator constFind(const Key &key) const noexcept
+    {
+        return constFindImpl(key);
+    }
+private:
+    template <typename K> iterator findImpl(const K &key)
     {
         if (isEmpty())
             return end();
@@ -1906,11 +2211,7 @@ public:
             return end();
         return iterator(it.toIterator(d));
     }
-    const_iterator find(const Key &key) const noexcept
-    {
-        return constFind(key);
-    }
-    const_iterator constFind(const Key &key) const noexcept
+    template <typename K> const_iterator constFindImpl(const K &key) const noexcept
     {
         if (isEmpty())
             return end();
@@ -1919,6 +2220,8 @@ public:
             return constEnd();
         return const_iterator(it.toIterator(d));
     }
+
+public:
     iterator insert(const Key &key, const T &value)
     {
         return emplace(key, value);
@@ -2023,6 +2326,11 @@ public:
     }
 
     qsizetype count(const Key &key) const noexcept
+    {
+        return countImpl(key);
+    }
+private:
+    template <typename K> qsizetype countImpl(const K &key) const noexcept
     {
         if (!d)
             return 0;
@@ -2039,6 +2347,7 @@ public:
         return n;
     }
 
+public:
     qsizetype count(const Key &key, const T &value) const noexcept
     {
         if (!d)
@@ -2118,6 +2427,96 @@ public:
     }
 
     QPair<iterator, iterator> equal_range(const Key &key)
+    {
+        return equal_range_impl(key);
+    }
+    QPair<const_iterator, const_iterator> equal_range(const Key &key) const noexcept
+    {
+        return equal_range_impl(key);
+    }
+
+    template <typename K>
+    using if_heterogeneously_searchable = QHashPrivate::if_heterogeneously_searchable_with<Key, K>;
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    qsizetype remove(const K &key)
+    {
+        return removeImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T take(const K &key)
+    {
+        return takeImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool contains(const K &key) const noexcept
+    {
+        return d ? d->findNode(key) != nullptr : false;
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    qsizetype count(const K &key) const noexcept
+    {
+        return countImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T value(const K &key) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return T();
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T value(const K &key, const T &defaultValue) const noexcept
+    {
+        if (auto *v = valueImpl(key))
+            return *v;
+        else
+            return defaultValue;
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    QList<T> values(const K &key) const
+    {
+        return valuesImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T &operator[](const K &key)
+    {
+        return operatorIndexImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const T operator[](const K &key) const noexcept
+    {
+        return value(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator find(const K &key)
+    {
+        return findImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator find(const K &key) const noexcept
+    {
+        return constFindImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator constFind(const K &key) const noexcept
+    {
+        return constFindImpl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    QPair<iterator, iterator> equal_range(const K &key)
+    {
+        return equal_range_impl(key);
+    }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    QPair<const_iterator, const_iterator> equal_range(const K &key) const noexcept
+    {
+        return equal_range_impl(key);
+    }
+
+private:
+    template <typename K> QPair<iterator, iterator> equal_range_impl(const K &key)
     {
         const auto copy = isDetached() ? QMultiHash() : *this; // keep 'key' alive across the detach
         detach();
@@ -2125,7 +2524,7 @@ public:
         return qMakePair(iterator(pair.first.i), iterator(pair.second.i));
     }
 
-    QPair<const_iterator, const_iterator> equal_range(const Key &key) const noexcept
+    template <typename K> QPair<const_iterator, const_iterator> equal_range_impl(const K &key) const noexcept
     {
         if (!d)
             return qMakePair(end(), end());
@@ -2139,7 +2538,6 @@ public:
         return qMakePair(const_iterator(it), const_iterator(end));
     }
 
-private:
     void detach_helper()
     {
         if (!d) {
@@ -161,6 +161,7 @@ inline Q_DECL_PURE_FUNCTION size_t qHash(const QString &key, size_t seed = 0) no
 #endif
 Q_CORE_EXPORT Q_DECL_PURE_FUNCTION size_t qHash(const QBitArray &key, size_t seed = 0) noexcept;
 Q_CORE_EXPORT Q_DECL_PURE_FUNCTION size_t qHash(QLatin1StringView key, size_t seed = 0) noexcept;
+Q_CORE_EXPORT Q_DECL_PURE_FUNCTION size_t qHash(QUtf8StringView key, size_t seed = 0) noexcept;
 Q_DECL_CONST_FUNCTION constexpr inline size_t qHash(QKeyCombination key, size_t seed = 0) noexcept
 { return qHash(key.toCombined(), seed); }
 Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qt_hash(QStringView key, uint chained = 0) noexcept;
@@ -173,12 +174,49 @@ template <typename T, std::enable_if_t<QHashPrivate::HasQHashSingleArgOverload<T
 size_t qHash(const T &t, size_t seed) noexcept(noexcept(qHash(t)))
 { return qHash(t) ^ seed; }
 
+template <typename Key, typename K>
+struct QHashHeterogeneousSearch : std::false_type {};
+
+template <> struct QHashHeterogeneousSearch<QString, QStringView> : std::true_type {};
+template <> struct QHashHeterogeneousSearch<QString, QLatin1StringView> : std::true_type {};
+template <> struct QHashHeterogeneousSearch<QString, QUtf8StringView> : std::true_type {};
+template <> struct QHashHeterogeneousSearch<QByteArray, QByteArrayView> : std::true_type {};
+
+namespace QHashPrivate {
+template <typename Key, typename K>
+using if_heterogeneously_searchable_with =
+        std::enable_if_t<QHashHeterogeneousSearch<Key, K>::value, bool>;
+
+// constructs the key to insert from the one that was searched for
+template <typename Key, typename K>
+Key heterogeneousKey(const K &key)
+{
+    if constexpr (std::is_constructible_v<Key, const K &>)
+        return Key(key);
+    else if constexpr (std::is_same_v<Key, QByteArray>)
+        return key.toByteArray();
+    else
+        return key.toString();
+}
+} // namespace QHashPrivate
+
 template<typename T>
 bool qHashEquals(const T &a, const T &b)
 {
     return a == b;
 }
 
+template <typename T, typename K, QHashPrivate::if_heterogeneously_searchable_with<T, K> = true>
+bool qHashEquals(const T &a, const K &b)
+{
+    return a == b;
+}
+
+inline bool qHashEquals(const QString &a, QUtf8StringView b) noexcept
+{
+    return QtPrivate::equalStrings(a, b);
+}
+
 namespace QtPrivate {
 
 struct QHashCombine
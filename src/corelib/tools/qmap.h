@@ -48,7 +48,8 @@ public:
 
     // used in remove(); copies from source all the values not matching key.
     // returns how many were NOT copied (removed).
-    size_type copyIfNotEquivalentTo(const Map &source, const Key &key)
+    template <typename K>
+    size_type copyIfNotEquivalentTo(const Map &source, const K &key)
     {
         Q_ASSERT(m.empty());
 
@@ -684,6 +685,153 @@ public:
         return const_iterator(d->m.upper_bound(key));
     }
 
+    template <typename K>
+    using if_heterogeneously_searchable = std::enable_if_t<
+            QHashHeterogeneousSearch<Key, K>::value
+            && std::is_invocable_r_v<bool, const typename Map::key_compare &, const Key &, const K &>
+            && std::is_invocable_r_v<bool, const typename Map::key_compare &, const K &, const Key &>,
+            bool>;
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    size_type remove(const K &key)
+    {
+        if (!d)
+            return 0;
+
+        if (!d.isShared()) {
+            // no heterogeneous std::map::erase() before C++23
+            const auto range = d->m.equal_range(key);
+            const size_type result = size_type(std::distance(range.first, range.second));
+            d->m.erase(range.first, range.second);
+            return result;
+        }
+
+        MapData *newData = new MapData;
+        size_type result = newData->copyIfNotEquivalentTo(d->m, key);
+
+        d.reset(newData);
+
+        return result;
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T take(const K &key)
+    {
+        if (!d)
+            return T();
+
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+
+        auto i = d->m.find(key);
+        if (i != d->m.end()) {
+            T result(std::move(i->second));
+            d->m.erase(i);
+            return result;
+        }
+        return T();
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool contains(const K &key) const
+    {
+        if (!d)
+            return false;
+        auto i = d->m.find(key);
+        return i != d->m.end();
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T value(const K &key, const T &defaultValue = T()) const
+    {
+        if (!d)
+            return defaultValue;
+        const auto i = d->m.find(key);
+        if (i != d->m.cend())
+            return i->second;
+        return defaultValue;
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T &operator[](const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        // only construct a Key if it isn't in the map yet
+        auto i = d->m.lower_bound(key);
+        if (i == d->m.end() || d->m.key_comp()(key, i->first))
+            i = d->m.emplace_hint(i, QHashPrivate::heterogeneousKey<Key>(key), T());
+        return i->second;
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    T operator[](const K &key) const
+    {
+        return value(key);
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    size_type count(const K &key) const
+    {
+        if (!d)
+            return 0;
+        return size_type(d->m.count(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator find(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.find(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator find(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.find(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator constFind(const K &key) const
+    {
+        return find(key);
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator lowerBound(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator lowerBound(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.lower_bound(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator upperBound(const K &key)
+    {
+        const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->m.upper_bound(key));
+    }
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator upperBound(const K &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->m.upper_bound(key));
+    }
+
     iterator insert(const Key &key, const T &value)
     {
         const auto copy = d.isShared() ? *this : QMap(); // keep `key` alive across the detach
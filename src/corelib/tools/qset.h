@@ -159,6 +159,21 @@ public:
     iterator find(const T &value) { return q_hash.find(value); }
     const_iterator find(const T &value) const { return q_hash.find(value); }
     inline const_iterator constFind(const T &value) const { return find(value); }
+
+    template <typename K>
+    using if_heterogeneously_searchable = QHashPrivate::if_heterogeneously_searchable_with<T, K>;
+
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool remove(const K &value) { return q_hash.remove(value) != 0; }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    bool contains(const K &value) const { return q_hash.contains(value); }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    iterator find(const K &value) { return q_hash.find(value); }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator find(const K &value) const { return q_hash.find(value); }
+    template <typename K, if_heterogeneously_searchable<K> = true>
+    const_iterator constFind(const K &value) const { return q_hash.constFind(value); }
+
     QSet<T> &unite(const QSet<T> &other);
     QSet<T> &intersect(const QSet<T> &other);
     bool intersects(const QSet<T> &other) const;
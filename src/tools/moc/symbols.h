@@ -37,7 +37,7 @@ struct SubArray
 
 inline size_t qHash(const SubArray &key)
 {
-    return qHash(QLatin1StringView(key.array.constData() + key.from, key.len));
+    return qHash(QByteArrayView(key.array.constData() + key.from, key.len));
 }
 
 
@@ -0,0 +1,219 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <qtconcurrentalgorithm.h>
+
+#include <QRandomGenerator>
+#include <QTest>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithm : public QObject
+{
+    Q_OBJECT
+private slots:
+    void sort_data();
+    void sort();
+    void sortStrings();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void sortIterators();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void inclusiveScanNonCommutative();
+    void partition_data() { sort_data(); }
+    void partition();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+};
+
+static QList<int> randomList(qsizetype size, int bound)
+{
+    QList<int> list(size);
+    QRandomGenerator generator(size);
+    for (int &i : list)
+        i = int(generator.bounded(bound));
+    return list;
+}
+
+void tst_QtConcurrentAlgorithm::sort_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("threads");
+
+    for (int size : { 0, 1, 100, 5000, 100000 }) {
+        for (int threads : { 1, 2, 3, 8 }) {
+            QTest::addRow("size=%d,threads=%d", size, threads) << size << threads;
+        }
+    }
+}
+
+void tst_QtConcurrentAlgorithm::sort()
+{
+    QFETCH(int, size);
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QList<int> list = randomList(size, size + 1);
+    QList<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QtConcurrent::sort(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::reverse(expected.begin(), expected.end());
+    QtConcurrent::blockingSort(&pool, list, std::greater<>());
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithm::sortStrings()
+{
+    // items that are not trivially destructible go through the buffer too
+    QStringList list;
+    for (int i : randomList(20000, 1000))
+        list.append(QString::number(i));
+    QStringList expected = list;
+    std::sort(expected.begin(), expected.end());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QtConcurrent::blockingSort(&pool, list);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithm::stableSort()
+{
+    QFETCH(int, size);
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    // few distinct keys, so that many items compare equal
+    QList<std::pair<int, int>> list;
+    const QList<int> keys = randomList(size, 10);
+    for (int i = 0; i < size; ++i)
+        list.append({ keys.at(i), i });
+    QList<std::pair<int, int>> expected = list;
+    const auto byKey = [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+        return a.first < b.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+
+    QtConcurrent::stableSort(&pool, list, byKey).waitForFinished();
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithm::sortIterators()
+{
+    QList<int> list = randomList(50000, 100);
+    QList<int> expected = list;
+    std::sort(expected.begin() + 100, expected.end() - 100);
+
+    QtConcurrent::sort(list.begin() + 100, list.end() - 100).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::vector<int> vector(expected.cbegin(), expected.cend());
+    std::stable_sort(expected.begin(), expected.end(), std::greater<>());
+    QtConcurrent::blockingStableSort(vector.begin(), vector.end(), std::greater<>());
+    QVERIFY(std::equal(vector.cbegin(), vector.cend(), expected.cbegin(), expected.cend()));
+}
+
+void tst_QtConcurrentAlgorithm::inclusiveScan()
+{
+    QFETCH(int, size);
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    const QList<int> values = randomList(size, 100);
+    QList<qint64> list(values.cbegin(), values.cend());
+    QList<qint64> expected = list;
+    std::partial_sum(expected.begin(), expected.end(), expected.begin());
+
+    QtConcurrent::inclusiveScan(&pool, list).waitForFinished();
+    QCOMPARE(list, expected);
+
+    std::partial_sum(expected.begin(), expected.end(), expected.begin(),
+                     [](qint64 a, qint64 b) { return qMax(a, b); });
+    QtConcurrent::blockingInclusiveScan(&pool, list.begin(), list.end(),
+                                        [](qint64 a, qint64 b) { return qMax(a, b); });
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithm::inclusiveScanNonCommutative()
+{
+    QStringList list;
+    for (int i = 0; i < 30000; ++i)
+        list.append(QString(QChar(u'a' + i % 26)));
+    QStringList expected = list;
+    // keep the strings short, only the order of the operands matters
+    const auto lastTwo = [](const QString &a, const QString &b) { return (a + b).right(2); };
+    std::partial_sum(expected.begin(), expected.end(), expected.begin(), lastTwo);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QtConcurrent::blockingInclusiveScan(&pool, list, lastTwo);
+    QCOMPARE(list, expected);
+}
+
+void tst_QtConcurrentAlgorithm::partition()
+{
+    QFETCH(int, size);
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    QList<int> list = randomList(size, 1000);
+    const QList<int> original = list;
+    const auto isSmall = [](int i) { return i < 300; };
+
+    QFuture<QList<int>::iterator> future = QtConcurrent::partition(&pool, list, isSmall);
+    const auto point = future.result();
+    QVERIFY(std::all_of(list.begin(), point, isSmall));
+    QVERIFY(std::none_of(point, list.end(), isSmall));
+    QCOMPARE(point - list.begin(), std::count_if(original.cbegin(), original.cend(), isSmall));
+    QVERIFY(std::is_permutation(list.cbegin(), list.cend(), original.cbegin(), original.cend()));
+
+    const auto isOdd = [](int i) { return i & 1; };
+    const auto second = QtConcurrent::blockingPartition(&pool, list.begin(), list.end(), isOdd);
+    QVERIFY(std::is_partitioned(list.begin(), list.end(), isOdd));
+    QVERIFY(std::all_of(list.begin(), second, isOdd));
+    QVERIFY(std::is_permutation(list.cbegin(), list.cend(), original.cbegin(), original.cend()));
+}
+
+#ifndef QT_NO_EXCEPTIONS
+class ComparisonException : public QException
+{
+public:
+    void raise() const override { throw *this; }
+    ComparisonException *clone() const override { return new ComparisonException(*this); }
+};
+
+void tst_QtConcurrentAlgorithm::exceptions()
+{
+    QStringList list;
+    for (int i : randomList(20000, 1000))
+        list.append(QString::number(i));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QAtomicInt comparisons;
+    const auto throwing = [&comparisons](const QString &a, const QString &b) {
+        if (comparisons.fetchAndAddRelaxed(1) == 50000)
+            throw ComparisonException();
+        return a < b;
+    };
+    QVERIFY_THROWS_EXCEPTION(ComparisonException,
+                             QtConcurrent::blockingSort(&pool, list, throwing));
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentAlgorithm)
+#include "tst_qtconcurrentalgorithm.moc"
@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <QThread>
 #include <QSet>
+#include <QMutex>
+
+#include <algorithm>
 
 struct TestIterator
 {
@@ -58,6 +61,8 @@ private slots:
     void noIterations();
     void throttling();
     void multipleResults();
+    void schedulingPolicy_data();
+    void schedulingPolicy();
 };
 
 QAtomicInt iterations;
@@ -246,6 +251,71 @@ void tst_QtConcurrentIterateKernel::multipleResults()
     f.waitForFinished();
 }
 
+class BlockRecordingFor : public IterateKernel<TestIterator, void>
+{
+public:
+    BlockRecordingFor(TestIterator begin, TestIterator end, QList<std::pair<int, int>> *blocks)
+        : IterateKernel<TestIterator, void>(QThreadPool::globalInstance(), begin, end),
+          blocks(blocks)
+    { }
+    bool runIterations(TestIterator/*beginIterator*/, int begin, int end, void *) override
+    {
+        QMutexLocker locker(&mutex);
+        blocks->append({ begin, end });
+        return false;
+    }
+
+    QMutex mutex;
+    QList<std::pair<int, int>> *blocks;
+};
+
+void tst_QtConcurrentIterateKernel::schedulingPolicy_data()
+{
+    QTest::addColumn<SchedulingPolicy>("policy");
+    QTest::addColumn<int>("iterationCount");
+
+    QTest::newRow("default") << SchedulingPolicy() << 1000;
+    QTest::newRow("adaptive") << SchedulingPolicy(SchedulingPolicy::Adaptive, 64) << 1000;
+    QTest::newRow("adaptive-small") << SchedulingPolicy(SchedulingPolicy::Adaptive, 64) << 10;
+    QTest::newRow("guided") << SchedulingPolicy(SchedulingPolicy::Guided) << 1000;
+    QTest::newRow("guided-grain") << SchedulingPolicy(SchedulingPolicy::Guided, 16) << 1000;
+    QTest::newRow("guided-invalid") << SchedulingPolicy(SchedulingPolicy::Guided, -5) << 100;
+}
+
+void tst_QtConcurrentIterateKernel::schedulingPolicy()
+{
+    QFETCH(SchedulingPolicy, policy);
+    QFETCH(int, iterationCount);
+
+    QVERIFY(policy.minimumBlockSize() >= 1);
+
+    QList<std::pair<int, int>> blocks;
+    auto kernel = new BlockRecordingFor(0, iterationCount, &blocks);
+    kernel->schedulingPolicy = policy;
+    startThreadEngine(kernel).startAsynchronously().waitForFinished();
+
+    // every iteration ran exactly once, in blocks of at least the minimum
+    // size unless they reach the end
+    std::sort(blocks.begin(), blocks.end());
+    int next = 0;
+    for (const auto &block : std::as_const(blocks)) {
+        QCOMPARE(block.first, next);
+        QVERIFY(block.second > block.first);
+        if (block.second < iterationCount)
+            QVERIFY(block.second - block.first >= policy.minimumBlockSize());
+        next = block.second;
+    }
+    QCOMPARE(next, iterationCount);
+
+    // the first guided block is a share of the whole sequence
+    if (policy.mode() == SchedulingPolicy::Guided) {
+        const int threadCount = QThreadPool::globalInstance()->maxThreadCount();
+        const int share = iterationCount / (2 * threadCount);
+        QCOMPARE(blocks.first().second,
+                 qMin(qMax(share, policy.minimumBlockSize()), iterationCount));
+    }
+}
+
 QTEST_MAIN(tst_QtConcurrentIterateKernel)
 
 #include "tst_qtconcurrentiteratekernel.moc"
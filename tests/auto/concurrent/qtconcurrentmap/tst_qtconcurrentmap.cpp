@@ -10,6 +10,8 @@
 #include <QSet>
 #include <QRandomGenerator>
 
+#include <numeric>
+
 #include "../testhelper_functions.h"
 
 class tst_QtConcurrentMap : public QObject
@@ -19,12 +21,14 @@ private slots:
     void map();
     void blockingMap();
     void mapOnRvalue();
+    void mapWithSchedulingPolicy();
     void mapped();
     void mappedThreadPool();
     void mappedWithMoveOnlyCallable();
     void mappedReduced();
     void mappedReducedThreadPool();
     void mappedReducedWithMoveOnlyCallable();
+    void mappedReducedParallel();
     void mappedReducedDifferentType();
     void mappedReducedInitialValue();
     void mappedReducedInitialValueThreadPool();
@@ -499,6 +503,32 @@ void testMapped(const QList<SourceObject> &sourceObjectList, const QList<ResultO
     QCOMPARE(result4, expectedResult);
 }
 
+void tst_QtConcurrentMap::mapWithSchedulingPolicy()
+{
+    QList<int> list(1000);
+    std::iota(list.begin(), list.end(), 0);
+    QList<int> expected = list;
+    for (int &i : expected)
+        i *= 2;
+
+    const SchedulingPolicy guided(SchedulingPolicy::Guided, 8);
+    QtConcurrent::map(list, multiplyBy2InPlace, guided).waitForFinished();
+    QCOMPARE(list, expected);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+    const SchedulingPolicy adaptive(SchedulingPolicy::Adaptive, 100);
+    QtConcurrent::map(&pool, list, MultiplyBy2InPlace(), adaptive).waitForFinished();
+    for (int &i : expected)
+        i *= 2;
+    QCOMPARE(list, expected);
+
+    QtConcurrent::blockingMap(list, [](int &x) { x /= 4; }, guided);
+    QtConcurrent::blockingMap(&pool, list, [](int &x) { x += 1; }, adaptive);
+    for (int i = 0; i < list.size(); ++i)
+        QCOMPARE(list.at(i), i + 1);
+}
+
 void tst_QtConcurrentMap::mapped()
 {
     const QList<int> intList {1, 2, 3};
@@ -1127,6 +1157,65 @@ void tst_QtConcurrentMap::mappedReducedWithMoveOnlyCallable()
     }
 }
 
+struct Histogram
+{
+    QList<int> buckets = QList<int>(10);
+};
+
+static void mergeHistograms(Histogram &histogram, const Histogram &other)
+{
+    for (int i = 0; i < 10; ++i)
+        histogram.buckets[i] += other.buckets.at(i);
+}
+
+void tst_QtConcurrentMap::mappedReducedParallel()
+{
+    QList<int> list(10000);
+    std::iota(list.begin(), list.end(), 0);
+    const auto identity = [](int x) { return x; };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    // the result and the intermediate results have the same type
+    {
+        const auto add = [](qint64 &sum, qint64 x) { sum += x; };
+        const auto square = [](int x) { return qint64(x) * x; };
+        const qint64 expected = std::accumulate(list.cbegin(), list.cend(), qint64(0),
+                                                [](qint64 sum, int x) { return sum + qint64(x) * x; });
+        QCOMPARE(QtConcurrent::blockingMappedReduced(&pool, list, square, add, ParallelReduce),
+                 expected);
+        QCOMPARE(QtConcurrent::mappedReduced(list, square, add, ParallelReduce).result(),
+                 expected);
+        // the initial value is combined with the accumulators only once
+        QCOMPARE(QtConcurrent::blockingMappedReduced(&pool, list, square, add, qint64(5),
+                                                     ParallelReduce),
+                 expected + 5);
+    }
+
+    // merging histograms
+    {
+        const auto toHistogram = [](int x) {
+            Histogram histogram;
+            ++histogram.buckets[x % 10];
+            return histogram;
+        };
+        const Histogram histogram = QtConcurrent::blockingMappedReduced(
+                &pool, list, toHistogram, mergeHistograms, ParallelReduce);
+        QCOMPARE(histogram.buckets, QList<int>(10, 1000));
+    }
+
+    // intermediate results of another type are reduced as for
+    // UnorderedReduce
+    {
+        const auto append = [](QList<int> &result, int x) { result.append(x); };
+        QList<int> result = QtConcurrent::blockingMappedReduced<QList<int>>(
+                &pool, list, identity, append, ParallelReduce);
+        std::sort(result.begin(), result.end());
+        QCOMPARE(result, list);
+    }
+}
+
 void tst_QtConcurrentMap::mappedReducedDifferentType()
 {
     const QList<int> intList {1, 2, 3};
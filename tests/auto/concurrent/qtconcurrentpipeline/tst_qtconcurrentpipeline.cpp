@@ -0,0 +1,353 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <qtconcurrentpipeline.h>
+
+#include <QTest>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+
+class tst_QtConcurrentPipeline : public QObject
+{
+    Q_OBJECT
+private slots:
+    void transform_data();
+    void transform();
+    void orderedResults_data() { transform_data(); }
+    void orderedResults();
+    void filter();
+    void inOrderStage();
+    void voidSink();
+    void moveOnly();
+    void parallelism();
+    void maxInFlight();
+    void statistics();
+    void cancel();
+#ifndef QT_NO_EXCEPTIONS
+    void exceptions();
+#endif
+};
+
+static QList<int> range(int count)
+{
+    QList<int> list(count);
+    std::iota(list.begin(), list.end(), 0);
+    return list;
+}
+
+// sleeps a little for some of the items, so that they overtake each other
+static void jitter(int i)
+{
+    if (i % 7 == 0)
+        QThread::usleep(200);
+}
+
+void tst_QtConcurrentPipeline::transform_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("parallelism");
+
+    for (int count : { 0, 1, 1000 }) {
+        for (int threads : { 1, 4 }) {
+            for (int parallelism : { 1, 3, 0 }) {
+                QTest::addRow("count=%d,threads=%d,parallelism=%d", count, threads, parallelism)
+                        << count << threads << parallelism;
+            }
+        }
+    }
+}
+
+void tst_QtConcurrentPipeline::transform()
+{
+    QFETCH(int, count);
+    QFETCH(int, threads);
+    QFETCH(int, parallelism);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    const QList<int> input = range(count);
+
+    QFuture<QString> future = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .then([](int i) { jitter(i); return i * 2; }).withParallelism(parallelism)
+            .then([](int i) { return QString::number(i); }).withParallelism(parallelism)
+            .start();
+
+    QList<QString> results = future.results();
+    QCOMPARE(results.size(), count);
+    std::sort(results.begin(), results.end(), [](const QString &a, const QString &b) {
+        return a.toInt() < b.toInt();
+    });
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(results.at(i), QString::number(i * 2));
+}
+
+void tst_QtConcurrentPipeline::orderedResults()
+{
+    QFETCH(int, count);
+    QFETCH(int, threads);
+    QFETCH(int, parallelism);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    const QList<int> input = range(count);
+
+    QFuture<int> future = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .then([](int i) -> std::optional<int> {
+                jitter(i);
+                if (i % 3 == 0)
+                    return std::nullopt;
+                return i;
+            }).withParallelism(parallelism)
+            .withOrderedResults()
+            .start();
+
+    QList<int> expected;
+    std::copy_if(input.cbegin(), input.cend(), std::back_inserter(expected),
+                 [](int i) { return i % 3 != 0; });
+    QCOMPARE(future.results(), expected);
+}
+
+void tst_QtConcurrentPipeline::filter()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    const QList<int> input = range(1000);
+
+    auto pipeline = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .filter([](int i) { return i % 2 == 0; }).withParallelism(2)
+            .then([](int i) { return i / 2; });
+    QList<int> results = pipeline.start().results();
+    std::sort(results.begin(), results.end());
+    QCOMPARE(results, range(500));
+
+    const QList<QtConcurrent::PipelineStageStatistics> statistics = pipeline.statistics();
+    QCOMPARE(statistics.size(), 3);
+    QCOMPARE(statistics.at(0).processed, 1000);
+    QCOMPARE(statistics.at(1).processed, 1000);
+    QCOMPARE(statistics.at(1).dropped, 500);
+    QCOMPARE(statistics.at(2).processed, 500);
+    QCOMPARE(statistics.at(2).dropped, 0);
+}
+
+void tst_QtConcurrentPipeline::inOrderStage()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    const QList<int> input = range(2000);
+
+    // the writer sees the items in order, even after parallel stages that
+    // drop some of them
+    QList<int> written;
+    QFuture<void> future = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .then([](int i) { jitter(i); return i; }).withParallelism(0)
+            .filter([](int i) { return i % 5 != 0; }).withParallelism(0)
+            .then([&written](int i) { written.append(i); }).inOrder()
+            .withMaxInFlight(16)
+            .start();
+    future.waitForFinished();
+
+    QList<int> expected;
+    std::copy_if(input.cbegin(), input.cend(), std::back_inserter(expected),
+                 [](int i) { return i % 5 != 0; });
+    QCOMPARE(written, expected);
+}
+
+void tst_QtConcurrentPipeline::voidSink()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(3);
+
+    int next = 0;
+    QAtomicInt sum;
+    QFuture<void> future = QtConcurrent::pipeline([&next]() -> std::optional<int> {
+                if (next == 100)
+                    return std::nullopt;
+                return next++;
+            })
+            .onThreadPool(pool)
+            .then([&sum](int i) { sum.fetchAndAddRelaxed(i); }).withParallelism(2)
+            .start();
+    future.waitForFinished();
+    QVERIFY(future.isFinished());
+    QVERIFY(!future.isCanceled());
+    QCOMPARE(sum.loadRelaxed(), 99 * 100 / 2);
+}
+
+void tst_QtConcurrentPipeline::moveOnly()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+
+    int next = 0;
+    QFuture<int> future =
+            QtConcurrent::pipeline([&next]() -> std::optional<std::unique_ptr<int>> {
+                if (next == 50)
+                    return std::nullopt;
+                return std::make_unique<int>(next++);
+            })
+            .onThreadPool(pool)
+            .then([](std::unique_ptr<int> p) { *p *= 2; return p; }).withParallelism(2)
+            .filter([](const std::unique_ptr<int> &p) { return *p % 4 == 0; })
+            .then([](std::unique_ptr<int> p) { return *p; })
+            .withOrderedResults()
+            .start();
+
+    QList<int> expected;
+    for (int i = 0; i < 50; i += 2)
+        expected.append(i * 2);
+    QCOMPARE(future.results(), expected);
+}
+
+void tst_QtConcurrentPipeline::parallelism()
+{
+    enum { Parallelism = 3 };
+    QThreadPool pool;
+    pool.setMaxThreadCount(6);
+    const QList<int> input = range(60);
+
+    QAtomicInt running;
+    QAtomicInt maxRunning;
+    const auto stage = [&](int i) {
+        const int now = running.fetchAndAddRelaxed(1) + 1;
+        int max = maxRunning.loadRelaxed();
+        while (now > max && !maxRunning.testAndSetRelaxed(max, now, max))
+            ;
+        QThread::msleep(2);
+        running.fetchAndSubRelaxed(1);
+        return i;
+    };
+
+    QFuture<int> future = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .then(stage).withParallelism(Parallelism)
+            .start();
+    QCOMPARE(future.results().size(), input.size());
+    QVERIFY(maxRunning.loadRelaxed() > 1);
+    QVERIFY(maxRunning.loadRelaxed() <= Parallelism);
+}
+
+void tst_QtConcurrentPipeline::maxInFlight()
+{
+    enum { MaxInFlight = 5 };
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    // the source is much faster than the last stage, so without
+    // backpressure the items would pile up in front of it
+    int next = 0;
+    QAtomicInt inFlight;
+    QAtomicInt maxInFlight;
+    QFuture<void> future = QtConcurrent::pipeline([&]() -> std::optional<int> {
+                if (next == 200)
+                    return std::nullopt;
+                const int now = inFlight.fetchAndAddRelaxed(1) + 1;
+                if (now > maxInFlight.loadRelaxed())
+                    maxInFlight.storeRelaxed(now);
+                return next++;
+            })
+            .onThreadPool(pool)
+            .then([](int i) { return i; }).withParallelism(2)
+            .then([&](int) {
+                QThread::usleep(500);
+                inFlight.fetchAndSubRelaxed(1);
+            }).inOrder()
+            .withMaxInFlight(MaxInFlight)
+            .start();
+    future.waitForFinished();
+    QCOMPARE(next, 200);
+    QCOMPARE(inFlight.loadRelaxed(), 0);
+    QVERIFY(maxInFlight.loadRelaxed() <= MaxInFlight);
+}
+
+void tst_QtConcurrentPipeline::statistics()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2);
+    const QList<int> input = range(20);
+
+    auto pipeline = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .named("source")
+            .then([](int i) { QThread::usleep(100); return i; }).named("slow")
+            .filter([](int i) { return i < 5; }).named("filter");
+
+    const auto before = pipeline.statistics();
+    QCOMPARE(before.size(), 3);
+    QCOMPARE(before.at(0).name, "source");
+    QCOMPARE(before.at(1).name, "slow");
+    QCOMPARE(before.at(2).name, "filter");
+    QCOMPARE(before.at(1).processed, 0);
+
+    QCOMPARE(pipeline.start().results().size(), 5);
+    const auto after = pipeline.statistics();
+    QCOMPARE(after.at(0).processed, 20);
+    QCOMPARE(after.at(1).processed, 20);
+    QCOMPARE(after.at(2).processed, 20);
+    QCOMPARE(after.at(2).dropped, 15);
+    QVERIFY(after.at(1).busyNSecs >= 20 * 100 * 1000);
+    for (const auto &stage : after) {
+        QCOMPARE(stage.queued, 0);
+        QCOMPARE(stage.active, 0);
+    }
+}
+
+void tst_QtConcurrentPipeline::cancel()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+
+    // an endless source
+    QAtomicInt produced;
+    QFuture<int> future = QtConcurrent::pipeline([&produced]() -> std::optional<int> {
+                return produced.fetchAndAddRelaxed(1);
+            })
+            .onThreadPool(pool)
+            .then([](int i) { QThread::usleep(100); return i; }).withParallelism(2)
+            .withMaxInFlight(8)
+            .start();
+    QTRY_VERIFY(future.resultCount() >= 10);
+    future.cancel();
+    future.waitForFinished();
+    QVERIFY(future.isCanceled());
+    QVERIFY(pool.waitForDone());
+    const int after = produced.loadRelaxed();
+    QThread::msleep(10);
+    QCOMPARE(produced.loadRelaxed(), after);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+class StageException : public QException
+{
+public:
+    void raise() const override { throw *this; }
+    StageException *clone() const override { return new StageException(*this); }
+};
+
+void tst_QtConcurrentPipeline::exceptions()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    const QList<int> input = range(1000);
+
+    QFuture<int> future = QtConcurrent::pipeline(input.cbegin(), input.cend())
+            .onThreadPool(pool)
+            .then([](int i) {
+                if (i == 100)
+                    throw StageException();
+                return i;
+            }).withParallelism(2)
+            .start();
+    QVERIFY_THROWS_EXCEPTION(StageException, future.waitForFinished());
+    QVERIFY(future.isCanceled());
+}
+#endif
+
+QTEST_MAIN(tst_QtConcurrentPipeline)
+#include "tst_qtconcurrentpipeline.moc"
@@ -507,6 +507,83 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+class SequenceEvent : public QEvent
+{
+public:
+    SequenceEvent(int sender, int sequence)
+        : QEvent(QEvent::User), sender(sender), sequence(sequence)
+    { }
+    int sender;
+    int sequence;
+};
+
+class SequenceRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    QList<QList<int>> received;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() == QEvent::User) {
+            auto e = static_cast<SequenceEvent *>(event);
+            record(e->sender, e->sequence);
+            return true;
+        }
+        return QObject::event(event);
+    }
+
+public slots:
+    void record(int sender, int sequence)
+    {
+        received[sender].append(sequence);
+    }
+};
+
+void tst_QCoreApplication::deliverInDefinedOrderFromManyThreads()
+{
+#if !QT_CONFIG(cxx11_future)
+    QSKIP("This test requires QThread::create");
+#else
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    // queued calls and other events posted by one thread must arrive in the
+    // order they were posted, no matter what the other threads are posting
+    constexpr int ThreadCount = 8;
+    constexpr int EventsPerThread = 2000;
+    SequenceRecorder recorder;
+    recorder.received.resize(ThreadCount);
+
+    QList<QThread *> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads << QThread::create([&recorder, t] {
+            for (int i = 0; i < EventsPerThread; ++i) {
+                if (i % 7 == 3)
+                    QCoreApplication::postEvent(&recorder, new SequenceEvent(t, i));
+                else
+                    QMetaObject::invokeMethod(&recorder, "record", Qt::QueuedConnection,
+                                              Q_ARG(int, t), Q_ARG(int, i));
+            }
+        });
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads)) {
+        while (!thread->wait(10))
+            QCoreApplication::sendPostedEvents();
+        delete thread;
+    }
+    QCoreApplication::sendPostedEvents();
+
+    for (int t = 0; t < ThreadCount; ++t) {
+        QCOMPARE(recorder.received.at(t).size(), EventsPerThread);
+        for (int i = 0; i < EventsPerThread; ++i)
+            QCOMPARE(recorder.received.at(t).at(i), i);
+    }
+#endif
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -8,6 +8,7 @@
 #include <qcoreevent.h>
 #include <qeventloop.h>
 #include <private/qeventloop_p.h>
+#include <private/qeventdispatchstatistics_p.h>
 #if defined(Q_OS_UNIX)
   #include <private/qeventdispatcher_unix_p.h>
   #include <QtCore/private/qcore_unix_p.h>
@@ -16,6 +17,7 @@
   #endif
 #endif
 #include <qmutex.h>
+#include <qscopeguard.h>
 #include <qthread.h>
 #include <qtimer.h>
 #include <qwaitcondition.h>
@@ -23,6 +25,8 @@
 #include <QTcpSocket>
 #include <QSignalSpy>
 
+#include <algorithm>
+
 class EventLoopExiter : public QObject
 {
     Q_OBJECT
@@ -149,6 +153,7 @@ private slots:
 #endif
     void processEventsExcludeTimers();
     void deliverInDefinedOrder();
+    void dispatchStatistics();
 
     // keep this test last:
     void nestedLoops();
@@ -324,6 +329,66 @@ void tst_QEventLoop::quit()
 }
 
 
+class SlowEventReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    bool event(QEvent *e) override
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        QThread::msleep(2);
+        return true;
+    }
+};
+
+void tst_QEventLoop::dispatchStatistics()
+{
+    QEventDispatchStatistics::reset();
+    QEventDispatchStatistics::setEnabled(true);
+    const auto cleanup = qScopeGuard([] {
+        QEventDispatchStatistics::setEnabled(false);
+        QEventDispatchStatistics::reset();
+    });
+
+    SlowEventReceiver receiver;
+    for (int i = 0; i < 5; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::User));
+    QEvent sent(QEvent::User);
+    QCoreApplication::sendEvent(&receiver, &sent);
+    QCoreApplication::sendPostedEvents(&receiver);
+
+    // not recorded
+    QEventDispatchStatistics::setEnabled(false);
+    QCoreApplication::sendEvent(&receiver, &sent);
+
+    const auto records = QEventDispatchStatistics::snapshot();
+    const auto it = std::find_if(records.cbegin(), records.cend(), [](const auto &r) {
+        return r.type == QEvent::User && r.className == "SlowEventReceiver";
+    });
+    QVERIFY(it != records.cend());
+
+    const QEventDispatchStatistics::Histogram &dispatch = it->dispatchTime;
+    QCOMPARE(dispatch.count, 6u);
+    QCOMPARE_GE(dispatch.total, 6 * 2'000'000);
+    QCOMPARE_GE(dispatch.maximum, 2'000'000);
+    QCOMPARE_GE(dispatch.percentile(0.5), 2'000'000);
+    QCOMPARE_LE(dispatch.percentile(0.5), dispatch.maximum);
+    quint64 bucketed = 0;
+    for (quint64 n : dispatch.buckets)
+        bucketed += n;
+    QCOMPARE(bucketed, dispatch.count);
+
+    // only the posted events waited in the queue; each one for at least as
+    // long as it took to deliver the sent event and those posted before it
+    const QEventDispatchStatistics::Histogram &wait = it->queueWait;
+    QCOMPARE(wait.count, 5u);
+    QCOMPARE_GE(wait.maximum, 5 * 2'000'000);
+
+    QEventDispatchStatistics::reset();
+    QVERIFY(QEventDispatchStatistics::snapshot().isEmpty());
+}
+
 void tst_QEventLoop::nestedLoops()
 {
     QCoreApplication::postEvent(this, new StartStopEvent(QEvent::User));
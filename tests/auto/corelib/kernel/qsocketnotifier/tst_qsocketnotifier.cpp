@@ -13,7 +13,10 @@
 #include <QtNetwork/QUdpSocket>
 #include <private/qnativesocketengine_p.h>
 #define NATIVESOCKETENGINE QNativeSocketEngine
+#include <private/qsocketnotifier_p.h>
+
 #ifdef Q_OS_UNIX
+#include <private/qeventdispatcher_unix_p.h>
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
 #endif
@@ -34,6 +37,8 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void edgeTriggered();
+    void group();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -335,6 +340,107 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+static bool dispatcherSupportsEdgeTriggering()
+{
+#if QT_CONFIG(epoll)
+    return qobject_cast<QEventDispatcherUNIX *>(QCoreApplication::eventDispatcher())
+            && qEnvironmentVariableIsEmpty("QT_NO_EPOLL");
+#else
+    return false;
+#endif
+}
+
+void tst_QSocketNotifier::edgeTriggered()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+
+    QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+    QSocketNotifierPrivate::get(&notifier)->setEdgeTriggered(true);
+    QSignalSpy spy(&notifier, &QSocketNotifier::activated);
+
+    // don't read the data, so the descriptor stays ready
+    QCOMPARE(qt_safe_write(fds[1], "a", 1), 1);
+    QTRY_VERIFY(spy.count() > 0);
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::processEvents();
+    if (dispatcherSupportsEdgeTriggering())
+        QCOMPARE(spy.count(), 1);
+
+    // more data is a new edge
+    const qsizetype before = spy.count();
+    QCOMPARE(qt_safe_write(fds[1], "b", 1), 1);
+    QTRY_VERIFY(spy.count() > before);
+
+    // switching back to level triggering reports the pending data again
+    QSocketNotifierPrivate::get(&notifier)->setEdgeTriggered(false);
+    const qsizetype levelBefore = spy.count();
+    for (int i = 0; i < 3; ++i)
+        QCoreApplication::processEvents();
+    QCOMPARE(spy.count(), levelBefore + 3);
+
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
+
+void tst_QSocketNotifier::group()
+{
+    int fds1[2];
+    int fds2[2];
+    QCOMPARE(qt_safe_pipe(fds1, O_NONBLOCK), 0);
+    QCOMPARE(qt_safe_pipe(fds2, O_NONBLOCK), 0);
+
+    QSocketNotifier n1(fds1[0], QSocketNotifier::Read);
+    QSocketNotifier n2(fds2[0], QSocketNotifier::Read);
+    QSignalSpy spy1(&n1, &QSocketNotifier::activated);
+    QSignalSpy spy2(&n2, &QSocketNotifier::activated);
+
+    QList<QSocketNotifier *> activated;
+    int activations = 0;
+    {
+        QSocketNotifierGroup group;
+        group.addNotifier(&n1);
+        group.addNotifier(&n2);
+        QCOMPARE(group.notifiers().size(), 2);
+
+        connect(&group, &QSocketNotifierGroup::activated, this,
+                [&](const QList<QSocketNotifier *> &notifiers) {
+            ++activations;
+            activated += notifiers;
+            char c;
+            for (QSocketNotifier *n : notifiers)
+                qt_safe_read(int(n->socket()), &c, 1);
+        });
+
+        QCOMPARE(qt_safe_write(fds1[1], "a", 1), 1);
+        QCOMPARE(qt_safe_write(fds2[1], "b", 1), 1);
+        QTRY_COMPARE(activated.size(), 2);
+        QVERIFY(activated.contains(&n1));
+        QVERIFY(activated.contains(&n2));
+        if (qobject_cast<QEventDispatcherUNIX *>(QCoreApplication::eventDispatcher()))
+            QCOMPARE(activations, 1);
+
+        // the grouped notifiers don't emit their own signal
+        QCOMPARE(spy1.count(), 0);
+        QCOMPARE(spy2.count(), 0);
+
+        group.removeNotifier(&n2);
+        QCOMPARE(group.notifiers(), QList<QSocketNotifier *>{ &n1 });
+    }
+
+    // n1 left the group when it was destroyed
+    QCOMPARE(qt_safe_write(fds1[1], "a", 1), 1);
+    QCOMPARE(qt_safe_write(fds2[1], "b", 1), 1);
+    QTRY_VERIFY(spy1.count() > 0);
+    QTRY_VERIFY(spy2.count() > 0);
+    QCOMPARE(activated.size(), 2);
+
+    n1.setEnabled(false);
+    n2.setEnabled(false);
+    for (int fd : { fds1[0], fds1[1], fds2[0], fds2[1] })
+        qt_safe_close(fd);
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
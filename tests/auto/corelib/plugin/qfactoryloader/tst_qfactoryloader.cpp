@@ -2,9 +2,12 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QtTest/qtest.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qcborvalue.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
@@ -23,12 +26,14 @@ class tst_QFactoryLoader : public QObject
 #endif
 
     QString binFolder;
+    QTemporaryDir cacheDir;
 public slots:
     void initTestCase();
 
 private slots:
     void usingTwoFactoriesFromSameDir();
     void extraSearchPath();
+    void metaDataCache();
 };
 
 static const char binFolderC[] = "bin";
@@ -40,6 +45,10 @@ void tst_QFactoryLoader::initTestCase()
     binFolder = QFINDTESTDATA(binFolderC);
     QVERIFY2(!binFolder.isEmpty(), "Unable to locate 'bin' folder");
 #endif
+
+    // must be set before the first plugin is scanned
+    QVERIFY(cacheDir.isValid());
+    qputenv("QT_PLUGIN_METADATA_CACHE", QFile::encodeName(cacheDir.filePath("plugins.cache")));
 }
 
 void tst_QFactoryLoader::usingTwoFactoriesFromSameDir()
@@ -109,5 +118,29 @@ void tst_QFactoryLoader::extraSearchPath()
 #endif
 }
 
+void tst_QFactoryLoader::metaDataCache()
+{
+#if !QT_CONFIG(library) || defined(Q_OS_ANDROID)
+    QSKIP("Test not applicable in this configuration.");
+#else
+    QFile cache(cacheDir.filePath("plugins.cache"));
+    QVERIFY2(cache.open(QIODevice::ReadOnly), qPrintable(cache.errorString()));
+    const QCborMap map = QCborValue::fromCbor(cache.readAll()).toMap();
+    QCOMPARE(map.value(QLatin1String("qtVersion")).toInteger(), QT_VERSION);
+
+    // the previous tests scanned both plugins, so both must have been cached
+    const QCborMap plugins = map.value(QLatin1String("plugins")).toMap();
+    int pluginCount = 0;
+    for (auto it : plugins) {
+        if (!QFileInfo(it.first.toString()).absolutePath().startsWith(QFileInfo(binFolder).canonicalFilePath()))
+            continue;
+        const QCborValue metaData = it.second.toArray().at(2);
+        if (metaData.isByteArray() && !metaData.toByteArray().isEmpty())
+            ++pluginCount;
+    }
+    QCOMPARE(pluginCount, 2);
+#endif
+}
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
@@ -0,0 +1,285 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QThread>
+#include <QThreadPool>
+#include <qcoroutine.h>
+#include <qpromise.h>
+
+#include <memory>
+
+#ifdef __cpp_lib_coroutine
+using namespace QtCoroutine;
+
+namespace {
+struct MoveOnly
+{
+    explicit MoveOnly(int value = 0) : value(value) {}
+    MoveOnly(MoveOnly &&) = default;
+    MoveOnly &operator=(MoveOnly &&) = default;
+    Q_DISABLE_COPY(MoveOnly)
+    int value;
+};
+
+// finishes the promise from a thread of its own, after a little while
+template <typename Function>
+void finishLater(Function &&function)
+{
+    QThread *thread = QThread::create([function = std::forward<Function>(function)]() mutable {
+        QThread::msleep(20);
+        function();
+    });
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+Task<int> valueOf(QFuture<int> future)
+{
+    co_return co_await future;
+}
+
+Task<int> sumOf(QFuture<int> a, QFuture<int> b)
+{
+    const int x = co_await valueOf(a);
+    const int y = co_await valueOf(b);
+    co_return x + y;
+}
+
+#ifndef QT_NO_EXCEPTIONS
+Task<int> throwing()
+{
+    throw std::runtime_error("task failed");
+    co_return 0;
+}
+
+Task<QString> catching()
+{
+    try {
+        co_await throwing();
+    } catch (const std::runtime_error &e) {
+        co_return QString::fromLatin1(e.what());
+    }
+    co_return QString();
+}
+#endif
+} // unnamed namespace
+#endif // __cpp_lib_coroutine
+
+class tst_QCoroutine : public QObject
+{
+    Q_OBJECT
+private slots:
+    void awaitFinishedFuture();
+    void awaitRunningFuture();
+    void awaitVoidFuture();
+    void awaitMoveOnlyFuture();
+#ifndef QT_NO_EXCEPTIONS
+    void awaitFutureWithException();
+    void taskException();
+#endif
+    void taskChain();
+    void resumeOnContext();
+    void resumeOnThreadPool();
+    void detachedTask();
+};
+
+#ifdef __cpp_lib_coroutine
+void tst_QCoroutine::awaitFinishedFuture()
+{
+    // doesn't suspend, so the result is available immediately
+    Task<int> task = valueOf(QtFuture::makeReadyFuture(42));
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), 42);
+}
+
+void tst_QCoroutine::awaitRunningFuture()
+{
+    QPromise<int> promise;
+    QFuture<int> future = promise.future();
+    promise.start();
+
+    QThread *resumedIn = nullptr;
+    auto coroutine = [&]() -> Task<int> {
+        const int value = co_await future;
+        resumedIn = QThread::currentThread();
+        co_return value;
+    };
+    Task<int> task = coroutine();
+    QVERIFY(!task.isFinished());
+
+    QThread *finishedIn = nullptr;
+    finishLater([&] {
+        finishedIn = QThread::currentThread();
+        promise.addResult(7);
+        promise.finish();
+    });
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), 7);
+    // no context was chosen, so it continued in the thread that finished the future
+    QCOMPARE(resumedIn, finishedIn);
+}
+
+void tst_QCoroutine::awaitVoidFuture()
+{
+    QPromise<void> promise;
+    promise.start();
+    bool resumed = false;
+    auto coroutine = [&](QFuture<void> future) -> Task<> {
+        co_await future;
+        resumed = true;
+    };
+    Task<> task = coroutine(promise.future());
+    QVERIFY(!resumed);
+    promise.finish();
+    QVERIFY(resumed);
+    QVERIFY(task.isFinished());
+}
+
+void tst_QCoroutine::awaitMoveOnlyFuture()
+{
+    QPromise<MoveOnly> promise;
+    promise.start();
+    auto coroutine = [](QFuture<MoveOnly> future) -> Task<int> {
+        MoveOnly value = co_await future;
+        co_return value.value;
+    };
+    Task<int> task = coroutine(promise.future());
+    promise.addResult(MoveOnly(5));
+    promise.finish();
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), 5);
+}
+
+#ifndef QT_NO_EXCEPTIONS
+void tst_QCoroutine::awaitFutureWithException()
+{
+    QPromise<int> promise;
+    promise.start();
+    Task<int> task = valueOf(promise.future());
+    promise.setException(std::make_exception_ptr(std::runtime_error("future failed")));
+    promise.finish();
+    QVERIFY(task.isFinished());
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, task.takeResult());
+}
+
+void tst_QCoroutine::taskException()
+{
+    Task<QString> task = catching();
+    QVERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), QLatin1String("task failed"));
+}
+#endif
+
+void tst_QCoroutine::taskChain()
+{
+    QPromise<int> a;
+    QPromise<int> b;
+    a.start();
+    b.start();
+    Task<int> task = sumOf(a.future(), b.future());
+
+    finishLater([&] {
+        b.addResult(2);
+        b.finish();
+        QThread::msleep(10);
+        a.addResult(40);
+        a.finish();
+    });
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), 42);
+}
+
+void tst_QCoroutine::resumeOnContext()
+{
+    QThread worker;
+    worker.start();
+    QObject workerContext;
+    workerContext.moveToThread(&worker);
+
+    QPromise<int> promise;
+    promise.start();
+
+    QThread *switchedTo = nullptr;
+    QThread *resumedIn = nullptr;
+    QThread *returnedTo = nullptr;
+    auto coroutine = [&](QFuture<int> future) -> Task<int> {
+        co_await resumeOn(&workerContext);
+        switchedTo = QThread::currentThread();
+        // the context sticks, even though the future is finished elsewhere
+        const int value = co_await future;
+        resumedIn = QThread::currentThread();
+        co_await resumeOn(this);
+        returnedTo = QThread::currentThread();
+        co_return value;
+    };
+    Task<int> task = coroutine(promise.future());
+    QVERIFY(!task.isFinished());
+
+    QTRY_COMPARE(switchedTo, &worker);
+    finishLater([&] {
+        promise.addResult(3);
+        promise.finish();
+    });
+    QTRY_VERIFY(task.isFinished());
+    QCOMPARE(task.takeResult(), 3);
+    QCOMPARE(resumedIn, &worker);
+    QCOMPARE(returnedTo, QThread::currentThread());
+
+    worker.quit();
+    QVERIFY(worker.wait());
+}
+
+void tst_QCoroutine::resumeOnThreadPool()
+{
+    QThreadPool pool;
+    QThread *resumedIn = nullptr;
+    auto coroutine = [&]() -> Task<> {
+        co_await resumeOn(&pool);
+        resumedIn = QThread::currentThread();
+    };
+    Task<> task = coroutine();
+    QVERIFY(pool.waitForDone());
+    QVERIFY(task.isFinished());
+    QVERIFY(resumedIn);
+    QVERIFY(resumedIn != QThread::currentThread());
+}
+
+void tst_QCoroutine::detachedTask()
+{
+    QPromise<int> promise;
+    promise.start();
+    auto finished = std::make_shared<bool>(false);
+    auto coroutine = [](QFuture<int> future, std::shared_ptr<bool> finished) -> Task<> {
+        co_await future;
+        *finished = true;
+    };
+    // dropping the task doesn't stop the coroutine
+    coroutine(promise.future(), finished);
+    QCOMPARE(finished.use_count(), 2);
+    promise.addResult(1);
+    promise.finish();
+    QVERIFY(*finished);
+    // and its frame is gone once it completes
+    QCOMPARE(finished.use_count(), 1);
+}
+#else
+// moc can't tell whether the compiler supports coroutines
+#define SKIP_TEST(name) \
+    void tst_QCoroutine::name() { QSKIP("This test requires C++20 coroutine support"); }
+SKIP_TEST(awaitFinishedFuture)
+SKIP_TEST(awaitRunningFuture)
+SKIP_TEST(awaitVoidFuture)
+SKIP_TEST(awaitMoveOnlyFuture)
+#ifndef QT_NO_EXCEPTIONS
+SKIP_TEST(awaitFutureWithException)
+SKIP_TEST(taskException)
+#endif
+SKIP_TEST(taskChain)
+SKIP_TEST(resumeOnContext)
+SKIP_TEST(resumeOnThreadPool)
+SKIP_TEST(detachedTask)
+#endif // __cpp_lib_coroutine
+
+QTEST_MAIN(tst_QCoroutine)
+#include "tst_qcoroutine.moc"
@@ -0,0 +1,349 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qcoreapplication.h>
+#include <qelapsedtimer.h>
+#include <qlockfreequeue.h>
+#include <qthread.h>
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+class tst_QLockFreeQueue : public QObject
+{
+    Q_OBJECT
+private slots:
+    void capacity();
+    void spscPushPop() { pushPop<QSpscQueue>(); }
+    void mpmcPushPop() { pushPop<QMpmcQueue>(); }
+    void spscBatches() { batches<QSpscQueue>(); }
+    void mpmcBatches() { batches<QMpmcQueue>(); }
+    void spscMoveOnly() { moveOnly<QSpscQueue>(); }
+    void mpmcMoveOnly() { moveOnly<QMpmcQueue>(); }
+    void spscDestroysValues() { destroysValues<QSpscQueue>(); }
+    void mpmcDestroysValues() { destroysValues<QMpmcQueue>(); }
+    void spscTimeout() { timeout<QSpscQueue>(); }
+    void mpmcTimeout() { timeout<QMpmcQueue>(); }
+    void spscProducerConsumer();
+    void mpmcProducersConsumers();
+    void spscNotification() { notification<QSpscQueue>(); }
+    void mpmcNotification() { notification<QMpmcQueue>(); }
+
+private:
+    template <template <typename> class Queue> void pushPop();
+    template <template <typename> class Queue> void batches();
+    template <template <typename> class Queue> void moveOnly();
+    template <template <typename> class Queue> void destroysValues();
+    template <template <typename> class Queue> void timeout();
+    template <template <typename> class Queue> void notification();
+};
+
+void tst_QLockFreeQueue::capacity()
+{
+    QCOMPARE(QSpscQueue<int>(1).capacity(), 1);
+    QCOMPARE(QSpscQueue<int>(2).capacity(), 2);
+    QCOMPARE(QSpscQueue<int>(3).capacity(), 4);
+    QCOMPARE(QMpmcQueue<int>(1).capacity(), 2);
+    QCOMPARE(QMpmcQueue<int>(16).capacity(), 16);
+    QCOMPARE(QMpmcQueue<int>(17).capacity(), 32);
+}
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::pushPop()
+{
+    Queue<int> queue(4);
+    QVERIFY(queue.isEmpty());
+
+    int value = -1;
+    QVERIFY(!queue.tryPop(&value));
+    QCOMPARE(value, -1);
+
+    // go around the ring a few times
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i)
+            QVERIFY(queue.tryPush(round * 10 + i));
+        QCOMPARE(queue.size(), 4);
+        QVERIFY(!queue.tryPush(42));
+        QVERIFY(!queue.tryEmplace(42));
+
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(queue.tryPop(&value));
+            QCOMPARE(value, round * 10 + i);
+        }
+        QVERIFY(!queue.tryPop(&value));
+        QVERIFY(queue.isEmpty());
+    }
+
+    QVERIFY(queue.tryEmplace(7));
+    QVERIFY(queue.pop(&value));
+    QCOMPARE(value, 7);
+}
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::batches()
+{
+    Queue<QString> queue(8);
+    const QStringList input = { "a", "b", "c", "d", "e", "f" };
+
+    QCOMPARE(queue.tryPush(input.cbegin(), input.cend()), 6);
+    QCOMPARE(queue.size(), 6);
+    // only two more fit
+    QCOMPARE(queue.tryPush(input.cbegin(), input.cend()), 2);
+    QCOMPARE(queue.tryPush(input.cbegin(), input.cend()), 0);
+
+    QStringList output;
+    QCOMPARE(queue.tryPop(std::back_inserter(output), 5), 5);
+    QCOMPARE(output, QStringList({ "a", "b", "c", "d", "e" }));
+
+    // wraps around the end of the ring
+    QCOMPARE(queue.tryPush(input.cbegin(), input.cbegin() + 4), 4);
+
+    output.clear();
+    QCOMPARE(queue.tryPop(std::back_inserter(output), 100), 7);
+    QCOMPARE(output, QStringList({ "f", "a", "b", "a", "b", "c", "d" }));
+    QCOMPARE(queue.tryPop(std::back_inserter(output), 100), 0);
+    QCOMPARE(queue.tryPop(std::back_inserter(output), 0), 0);
+}
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::moveOnly()
+{
+    Queue<std::unique_ptr<int>> queue(2);
+    QVERIFY(queue.tryPush(std::make_unique<int>(1)));
+    QVERIFY(queue.tryEmplace(new int(2)));
+
+    // a push that fails leaves the value alone
+    auto third = std::make_unique<int>(3);
+    QVERIFY(!queue.tryPush(std::move(third)));
+    QVERIFY(third);
+
+    std::vector<std::unique_ptr<int>> values;
+    QCOMPARE(queue.tryPop(std::back_inserter(values), 2), 2);
+    QCOMPARE(*values[0], 1);
+    QCOMPARE(*values[1], 2);
+
+    QCOMPARE(queue.tryPush(std::make_move_iterator(values.begin()),
+                           std::make_move_iterator(values.end())), 2);
+    QVERIFY(!values[0]);
+    std::unique_ptr<int> value;
+    QVERIFY(queue.tryPop(&value));
+    QCOMPARE(*value, 1);
+}
+
+namespace {
+struct Counted
+{
+    static inline int instances = 0;
+    Counted() { ++instances; }
+    Counted(const Counted &) { ++instances; }
+    Counted(Counted &&) noexcept { ++instances; }
+    Counted &operator=(const Counted &) = default;
+    Counted &operator=(Counted &&) noexcept = default;
+    ~Counted() { --instances; }
+};
+} // unnamed namespace
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::destroysValues()
+{
+    Counted::instances = 0;
+    {
+        Queue<Counted> queue(4);
+        QCOMPARE(Counted::instances, 0);
+        for (int i = 0; i < 3; ++i)
+            QVERIFY(queue.tryEmplace());
+        QCOMPARE(Counted::instances, 3);
+
+        Counted value;
+        QVERIFY(queue.tryPop(&value));
+        QCOMPARE(Counted::instances, 3);
+    }
+    QCOMPARE(Counted::instances, 0);
+}
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::timeout()
+{
+    Queue<int> queue(1);
+    int value = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!queue.pop(&value, QDeadlineTimer(100)));
+    QVERIFY(timer.elapsed() >= 90);
+    QVERIFY(!queue.pop(&value, QDeadlineTimer(0)));
+
+    for (qsizetype i = 0; i < queue.capacity(); ++i)
+        QVERIFY(queue.push(1, QDeadlineTimer(0)));
+    timer.start();
+    QVERIFY(!queue.push(2, QDeadlineTimer(100)));
+    QVERIFY(timer.elapsed() >= 90);
+
+    // a consumer frees up space while the producer waits
+    std::unique_ptr<QThread> consumer(QThread::create([&] {
+        QThread::msleep(50);
+        int popped;
+        QVERIFY(queue.tryPop(&popped));
+        QCOMPARE(popped, 1);
+    }));
+    consumer->start();
+    QVERIFY(queue.push(2));
+    QVERIFY(consumer->wait());
+    for (qsizetype i = 1; i < queue.capacity(); ++i) {
+        QVERIFY(queue.pop(&value, QDeadlineTimer(0)));
+        QCOMPARE(value, 1);
+    }
+    QVERIFY(queue.pop(&value, QDeadlineTimer(0)));
+    QCOMPARE(value, 2);
+}
+
+void tst_QLockFreeQueue::spscProducerConsumer()
+{
+    enum { Count = 100000 };
+    // small enough to make both threads wait for each other
+    QSpscQueue<int> queue(16);
+
+    std::unique_ptr<QThread> producer(QThread::create([&] {
+        int values[7];
+        for (int i = 0; i < Count;) {
+            if (i % 3) {
+                queue.push(i++);
+                continue;
+            }
+            const int n = qMin(Count - i, 7);
+            for (int j = 0; j < n; ++j)
+                values[j] = i + j;
+            i += int(queue.tryPush(values, values + n));
+        }
+    }));
+    producer->start();
+
+    int expected = 0;
+    int values[5];
+    while (expected < Count) {
+        if (expected % 2) {
+            int value;
+            QVERIFY(queue.pop(&value));
+            QCOMPARE(value, expected++);
+            continue;
+        }
+        const qsizetype n = queue.tryPop(values, 5);
+        for (qsizetype i = 0; i < n; ++i)
+            QCOMPARE(values[i], expected++);
+    }
+    QVERIFY(producer->wait());
+    QVERIFY(queue.isEmpty());
+}
+
+void tst_QLockFreeQueue::mpmcProducersConsumers()
+{
+    enum { Producers = 3, Consumers = 3, Count = 20000 };
+    QMpmcQueue<int> queue(32);
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int p = 0; p < Producers; ++p) {
+        threads.emplace_back(QThread::create([&queue, p] {
+            for (int i = 0; i < Count; ++i)
+                queue.push(p * Count + i);
+        }));
+    }
+
+    // each consumer must see the values of each producer in order
+    QAtomicInt failures;
+    std::vector<int> seen(Producers * Count);
+    for (int c = 0; c < Consumers; ++c) {
+        threads.emplace_back(QThread::create([&] {
+            int last[Producers];
+            std::fill(std::begin(last), std::end(last), -1);
+            int value;
+            while (queue.pop(&value) && value >= 0) {
+                const int producer = value / Count;
+                if (value % Count <= last[producer])
+                    failures.ref();
+                last[producer] = value % Count;
+                ++seen[value];
+            }
+        }));
+    }
+    for (auto &thread : threads)
+        thread->start();
+
+    for (int p = 0; p < Producers; ++p)
+        QVERIFY(threads[p]->wait());
+    for (int c = 0; c < Consumers; ++c)
+        queue.push(-1);
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(failures.loadRelaxed(), 0);
+    QCOMPARE(std::count(seen.cbegin(), seen.cend(), 1), qsizetype(seen.size()));
+    QVERIFY(queue.isEmpty());
+}
+
+namespace {
+template <typename Queue>
+class Receiver : public QObject
+{
+public:
+    explicit Receiver(Queue &queue) : queue(queue) {}
+
+    static QEvent::Type eventType()
+    {
+        static const auto type = QEvent::Type(QEvent::registerEventType());
+        return type;
+    }
+
+    bool event(QEvent *e) override
+    {
+        if (e->type() != eventType())
+            return QObject::event(e);
+        ++events;
+        int values[16];
+        while (qsizetype n = queue.tryPop(values, 16))
+            popped += int(n);
+        return true;
+    }
+
+    Queue &queue;
+    int events = 0;
+    int popped = 0;
+};
+} // unnamed namespace
+
+template <template <typename> class Queue>
+void tst_QLockFreeQueue::notification()
+{
+    enum { Count = 1000 };
+    Queue<int> queue(Count);
+    Receiver<Queue<int>> receiver(queue);
+    queue.setNotificationReceiver(&receiver, receiver.eventType());
+
+    // a burst of values is one event
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(queue.tryPush(i));
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.events, 1);
+    QCOMPARE(receiver.popped, 10);
+
+    std::unique_ptr<QThread> producer(QThread::create([&] {
+        for (int i = 0; i < Count; ++i)
+            queue.push(i);
+    }));
+    producer->start();
+    QTRY_COMPARE(receiver.popped, 10 + Count);
+    QVERIFY(producer->wait());
+    QVERIFY(receiver.events <= 1 + Count);
+
+    queue.setNotificationReceiver(nullptr, receiver.eventType());
+    const int events = receiver.events;
+    QVERIFY(queue.tryPush(1));
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver.events, events);
+}
+
+QTEST_MAIN(tst_QLockFreeQueue)
+#include "tst_qlockfreequeue.moc"
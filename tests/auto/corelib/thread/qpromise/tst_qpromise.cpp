@@ -23,6 +23,7 @@ private slots:
     void futureFromPromise();
     void addResult();
     void addResultOutOfOrder();
+    void addResults();
 #ifndef QT_NO_EXCEPTIONS
     void setException();
 #endif
@@ -229,6 +230,35 @@ void tst_QPromise::addResultOutOfOrder()
     }
 }
 
+void tst_QPromise::addResults()
+{
+    QPromise<int> promise;
+    auto f = promise.future();
+    promise.start();
+
+    QVERIFY(!promise.addResults({}));
+    QVERIFY(promise.addResults({ 0, 1, 2 }));
+    for (int i = 3; i < 1000; ++i)
+        QVERIFY(promise.addResult(i));
+    QVERIFY(promise.addResults({ 1000, 1001 }));
+    QVERIFY(!promise.addResults({ -1 }, 0)); // overwrite does not work
+    QCOMPARE(f.resultCount(), 1002);
+
+    // read the results in spans, without copying them
+    int index = 0;
+    while (index < f.resultCount()) {
+        int count = 0;
+        const int *results = f.contiguousResultsAt(index, &count);
+        QVERIFY(results);
+        QVERIFY(count > 0);
+        for (int i = 0; i < count; ++i)
+            QCOMPARE(results[i], index + i);
+        index += count;
+    }
+    QCOMPARE(index, 1002);
+    promise.finish();
+}
+
 #ifndef QT_NO_EXCEPTIONS
 void tst_QPromise::setException()
 {
@@ -12,6 +12,8 @@
 #include <private/qemulationdetector_p.h>
 #include <private/qvolatile_p.h>
 
+#include <memory>
+
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
@@ -62,6 +64,8 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void writerBlocksNewReaders();
+    void timedOutWriterLetsReadersIn();
 
 /*
     Performance tests
@@ -854,6 +858,55 @@ void tst_QReadWriteLock::deleteOnUnlock()
     }
 }
 
+void tst_QReadWriteLock::writerBlocksNewReaders()
+{
+    QReadWriteLock rwlock;
+    rwlock.lockForRead();
+
+    QAtomicInt writerLocked = 0;
+    std::unique_ptr<QThread> writer(QThread::create([&] {
+        rwlock.lockForWrite();
+        writerLocked.storeRelaxed(1);
+        rwlock.unlock();
+    }));
+    writer->start();
+
+    // once the writer waits, no new reader may get in
+    const auto tryRead = [&] {
+        if (!rwlock.tryLockForRead())
+            return false;
+        rwlock.unlock();
+        return true;
+    };
+    QTRY_VERIFY(!tryRead());
+    QCOMPARE(writerLocked.loadRelaxed(), 0);
+
+    rwlock.unlock();
+    QVERIFY(writer->wait());
+    QCOMPARE(writerLocked.loadRelaxed(), 1);
+    QVERIFY(tryRead());
+}
+
+void tst_QReadWriteLock::timedOutWriterLetsReadersIn()
+{
+    QReadWriteLock rwlock;
+    rwlock.lockForRead();
+
+    bool writerLocked = true;
+    std::unique_ptr<QThread> writer(QThread::create([&] {
+        writerLocked = rwlock.tryLockForWrite(100);
+    }));
+    writer->start();
+    QVERIFY(writer->wait());
+    QVERIFY(!writerLocked);
+
+    // the writer gave up, so readers don't need to wait for it anymore
+    QVERIFY(rwlock.tryLockForRead());
+    rwlock.unlock();
+    rwlock.unlock();
+    QVERIFY(rwlock.tryLockForWrite());
+    rwlock.unlock();
+}
 
 void tst_QReadWriteLock::uncontendedLocks()
 {
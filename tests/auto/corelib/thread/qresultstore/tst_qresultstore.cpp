@@ -35,6 +35,8 @@ private slots:
     void count();
     void pendingResultsDoNotLeak_data();
     void pendingResultsDoNotLeak();
+    void chunkedResults();
+    void contiguousResultsAt();
 private:
     int int0;
     int int1;
@@ -585,5 +587,101 @@ void tst_QtConcurrentResultStore::pendingResultsDoNotLeak()
     store.addResults(44, &lvalueListOfObj);
 }
 
+void tst_QtConcurrentResultStore::chunkedResults()
+{
+    CountedObject::LeakChecker leakChecker; Q_UNUSED(leakChecker)
+
+    QtPrivate::ResultStoreBase store;
+    auto cleanGuard = qScopeGuard([&] { store.clear<CountedObject>(); });
+
+    const int count = 10000;
+    const CountedObject *first = nullptr;
+    const CountedObject *second = nullptr;
+    for (int i = 0; i < count; ++i) {
+        CountedObject object;
+        object.id = i;
+        QCOMPARE(i % 2 ? store.moveResult(-1, std::move(object)) : store.addResult(-1, &object), i);
+        if (i == 0)
+            first = store.resultAt(0).pointer<CountedObject>();
+        else if (i == 1)
+            second = store.resultAt(1).pointer<CountedObject>();
+    }
+    QCOMPARE(store.count(), count);
+    QCOMPARE(CountedObject::liveCount, size_t(count));
+
+    // results don't move while more are appended
+    QCOMPARE(store.resultAt(0).pointer<CountedObject>(), first);
+    QCOMPARE(store.resultAt(1).pointer<CountedObject>(), second);
+
+    // the first result is kept on its own, the following ones in chunks
+    QVERIFY(!store.resultAt(0).isVector());
+    QVERIFY(store.resultAt(1).isVector());
+    QVERIFY(store.resultAt(1).batchSize() > 1);
+
+    int expected = 0;
+    for (ResultIteratorBase it = store.begin(); it != store.end(); ++it)
+        QCOMPARE(it.value<CountedObject>().id, expected++);
+    QCOMPARE(expected, count);
+
+    // a result past the insert index ends the chunk, and the gap is filled later
+    CountedObject later;
+    later.id = count + 1;
+    QCOMPARE(store.addResult(count + 1, &later), count + 1);
+    QCOMPARE(store.count(), count);
+    CountedObject gap;
+    gap.id = count;
+    QCOMPARE(store.addResult(count, &gap), count);
+    QCOMPARE(store.count(), count + 2);
+    QCOMPARE(store.resultAt(count).value<CountedObject>().id, count);
+    QCOMPARE(store.resultAt(count + 1).value<CountedObject>().id, count + 1);
+
+    // an index that is already taken is still rejected
+    QCOMPARE(store.addResult(5, &gap), -1);
+}
+
+void tst_QtConcurrentResultStore::contiguousResultsAt()
+{
+    QtPrivate::ResultStoreBase store;
+    IntResultsCleaner cleanGuard(store);
+
+    int n = 0;
+    QCOMPARE(store.contiguousResultsAt<int>(0, &n), nullptr);
+    QCOMPARE(n, 0);
+
+    for (int i = 0; i < 3; ++i)
+        store.addResult(-1, &i);
+    // small batches are appended to the chunk
+    const QList<int> small { 3, 4 };
+    QCOMPARE(store.addResults(-1, &small, small.size()), 3);
+    // large ones are stored as they are
+    QList<int> large;
+    for (int i = 5; i < 205; ++i)
+        large.append(i);
+    QCOMPARE(store.addResults(-1, &large, large.size()), 5);
+    QCOMPARE(store.count(), 205);
+
+    const int *results = store.contiguousResultsAt<int>(0, &n);
+    QCOMPARE(n, 1);
+    QCOMPARE(results[0], 0);
+
+    results = store.contiguousResultsAt<int>(2, &n);
+    QCOMPARE(n, 3);
+    QCOMPARE(results[0], 2);
+    QCOMPARE(results[2], 4);
+
+    results = store.contiguousResultsAt<int>(105, &n);
+    QCOMPARE(n, 100);
+    QCOMPARE(results, large.constData() + 100);
+
+    // reading in spans visits every result once
+    int index = 0;
+    while ((results = store.contiguousResultsAt<int>(index, &n))) {
+        for (int i = 0; i < n; ++i)
+            QCOMPARE(results[i], index + i);
+        index += n;
+    }
+    QCOMPARE(index, 205);
+}
+
 QTEST_MAIN(tst_QtConcurrentResultStore)
 #include "tst_qresultstore.moc"
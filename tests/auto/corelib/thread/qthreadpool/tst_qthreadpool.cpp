@@ -13,6 +13,9 @@
 #ifdef Q_OS_UNIX
 #include <unistd.h>
 #endif
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
 
 typedef void (*FunctionPointer)();
 
@@ -72,6 +75,10 @@ private slots:
     void tryStartCount();
     void priorityStart_data();
     void priorityStart();
+    void deadlineStart();
+    void priorityAging_data();
+    void priorityAging();
+    void queueStatistics();
     void waitForDone();
     void clear();
     void clearWithAutoDelete();
@@ -79,6 +86,8 @@ private slots:
     void waitForDoneTimeout();
     void destroyingWaitsForTasksToFinish();
     void stackSize();
+    void cpuAffinity();
+    void poolsPerNumaNode();
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
@@ -996,6 +1005,92 @@ void tst_QThreadPool::priorityStart()
     QCOMPARE(firstStarted.loadRelaxed(), expected);
 }
 
+void tst_QThreadPool::deadlineStart()
+{
+    QSemaphore sem;
+    QList<int> order;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    // keep the only thread busy while the others are queued
+    threadPool.start([&sem] { sem.acquire(); });
+    const auto record = [&order](int id) { return [&order, id] { order.append(id); }; };
+    threadPool.start(record(1), 10);
+    threadPool.start(record(2), QDeadlineTimer(20000));
+    threadPool.start(record(3), 0);
+    threadPool.start(record(4), QDeadlineTimer(10000));
+    threadPool.start(record(5), QDeadlineTimer(QDeadlineTimer::Forever));
+
+    sem.release();
+    QVERIFY(threadPool.waitForDone());
+    // earliest deadline first, then by priority; forever means no deadline
+    QCOMPARE(order, QList<int>({ 4, 2, 1, 3, 5 }));
+}
+
+void tst_QThreadPool::priorityAging_data()
+{
+    QTest::addColumn<int>("interval");
+    QTest::addColumn<QList<int>>("expected");
+
+    QTest::newRow("disabled") << 0 << QList<int>({ 1, 2, 0 });
+    QTest::newRow("10ms") << 10 << QList<int>({ 0, 1, 2 });
+}
+
+void tst_QThreadPool::priorityAging()
+{
+    QFETCH(int, interval);
+    QFETCH(QList<int>, expected);
+
+    QSemaphore sem;
+    QList<int> order;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setPriorityAgingInterval(interval);
+    QCOMPARE(threadPool.priorityAgingInterval(), interval);
+
+    threadPool.start([&sem] { sem.acquire(); });
+    threadPool.start([&order] { order.append(0); }, 0);
+    // after 100 ms, the first runnable is worth 10 levels more with aging
+    QThread::msleep(100);
+    threadPool.start([&order] { order.append(1); }, 5);
+    threadPool.start([&order] { order.append(2); }, 5);
+
+    sem.release();
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(order, expected);
+}
+
+void tst_QThreadPool::queueStatistics()
+{
+    QSemaphore sem;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    QCOMPARE(threadPool.queueStatistics().queuedTasks, 0);
+
+    threadPool.start([&sem] { sem.acquire(); });
+    threadPool.start([] {});
+    threadPool.start([] {}, 2);
+    threadPool.start([] {}, QDeadlineTimer(10));
+    threadPool.start([] {}, QDeadlineTimer(60000));
+    QThread::msleep(50);
+    sem.release();
+    QVERIFY(threadPool.waitForDone());
+
+    QThreadPool::QueueStatistics statistics = threadPool.queueStatistics();
+    // the first one started right away
+    QCOMPARE(statistics.queuedTasks, 4);
+    QCOMPARE(statistics.missedDeadlines, 1);
+    QVERIFY(statistics.maximumWaitNSecs >= 40 * 1000 * 1000);
+    QVERIFY(statistics.totalWaitNSecs >= 4 * 40 * 1000 * 1000);
+
+    threadPool.resetQueueStatistics();
+    statistics = threadPool.queueStatistics();
+    QCOMPARE(statistics.queuedTasks, 0);
+    QCOMPARE(statistics.totalWaitNSecs, 0);
+    QCOMPARE(statistics.maximumWaitNSecs, 0);
+    QCOMPARE(statistics.missedDeadlines, 0);
+}
+
 void tst_QThreadPool::waitForDone()
 {
     QElapsedTimer total, pass;
@@ -1251,6 +1346,64 @@ void tst_QThreadPool::stackSize()
     QCOMPARE(threadStackSize, targetStackSize);
 }
 
+#ifdef Q_OS_LINUX
+static QList<int> currentThreadCpus()
+{
+    cpu_set_t cpuset;
+    if (sched_getaffinity(0, sizeof(cpuset), &cpuset) != 0)
+        return {};
+    QList<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &cpuset))
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+#endif
+
+void tst_QThreadPool::cpuAffinity()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("Checking the CPU affinity is only implemented on Linux.");
+#else
+    const QList<int> allowed = currentThreadCpus();
+    QVERIFY(!allowed.isEmpty());
+    const QList<int> target = { allowed.last() };
+
+    QThreadPool threadPool;
+    QVERIFY(threadPool.threadCpuAffinity().isEmpty());
+    threadPool.setThreadCpuAffinity(target);
+    QCOMPARE(threadPool.threadCpuAffinity(), target);
+
+    QList<int> used;
+    threadPool.start([&used] { used = currentThreadCpus(); });
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(used, target);
+
+    // threads started afterwards are not restricted
+    threadPool.setThreadCpuAffinity({});
+    threadPool.start([&used] { used = currentThreadCpus(); });
+    QVERIFY(threadPool.waitForDone(30000));
+    QCOMPARE(used, allowed);
+#endif
+}
+
+void tst_QThreadPool::poolsPerNumaNode()
+{
+    QObject parent;
+    const QList<QThreadPool *> pools = QThreadPool::createPoolsPerNumaNode(&parent);
+    QVERIFY(!pools.isEmpty());
+    for (QThreadPool *pool : pools) {
+        QCOMPARE(pool->parent(), &parent);
+        if (pools.size() > 1)
+            QCOMPARE(pool->maxThreadCount(), pool->threadCpuAffinity().size());
+
+        QSemaphore done;
+        pool->start([&done] { done.release(); });
+        QVERIFY(done.tryAcquire(1, 30000));
+    }
+}
+
 void tst_QThreadPool::stressTest()
 {
     class Task : public QRunnable
@@ -2,11 +2,10 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #define QT_USE_QSTRINGBUILDER
-#define QFLATMAP_ENABLE_STL_COMPATIBLE_INSERT
 
 #include <QTest>
 
-#include <private/qflatmap_p.h>
+#include <qflatmap.h>
 #include <qbytearray.h>
 #include <qstring.h>
 #include <qstringview.h>
@@ -16,6 +15,8 @@
 #include <list>
 #include <tuple>
 
+using namespace Qt::StringLiterals;
+
 static constexpr bool is_even(int n) { return n % 2 == 0; }
 static constexpr bool is_empty(QAnyStringView v) { return v.isEmpty(); }
 
@@ -38,6 +39,7 @@ private slots:
     void constAccess();
     void insertion();
     void insertRValuesAndLValues();
+    void bulkInsertion();
     void removal();
     void extraction();
     void iterators();
@@ -47,9 +49,11 @@ private slots:
     void statefulComparator();
     void transparency_using();
     void transparency_struct();
+    void transparency_strings();
     void try_emplace_and_insert_or_assign();
     void viewIterators();
     void varLengthArray();
+    void flatSet();
 
 private:
     template <typename Compare>
@@ -160,6 +164,25 @@ void tst_QFlatMap::insertion()
     QCOMPARE(m.value("gnampf").data(), "GNAMPF");
 }
 
+void tst_QFlatMap::bulkInsertion()
+{
+    using Map = QFlatMap<int, QByteArray>;
+    const std::vector<Map::value_type> unsorted = {
+        { 5, "five" }, { 1, "one" }, { 3, "three" }, { 1, "uno" }, { 4, "four" }
+    };
+    Map m(unsorted.begin(), unsorted.end());
+    QCOMPARE(m.keys(), QList<int>({ 1, 3, 4, 5 }));
+    // the first of equivalent items is kept
+    QCOMPARE(m.value(1), "one");
+
+    const std::vector<Map::value_type> more = {
+        { 6, "six" }, { 3, "drie" }, { 0, "zero" }, { 2, "two" }, { 0, "nul" }
+    };
+    m.insert(more.begin(), more.end());
+    QCOMPARE(m.keys(), QList<int>({ 0, 1, 2, 3, 4, 5, 6 }));
+    QCOMPARE(m.values(), QList<QByteArray>({ "zero", "one", "two", "three", "four", "five", "six" }));
+}
+
 void tst_QFlatMap::insertRValuesAndLValues()
 {
     using Map = QFlatMap<QByteArray, QByteArray>;
@@ -499,6 +522,21 @@ void tst_QFlatMap::transparency_struct()
     transparency_impl<StringViewCompare>();
 }
 
+void tst_QFlatMap::transparency_strings()
+{
+    // std::less<QString> and std::less<QByteArray> are transparent
+    QFlatMap<QString, int> m({ { u"one"_s, 1 }, { u"two"_s, 2 } });
+    QCOMPARE(m.value(QStringView(u"two")), 2);
+    QCOMPARE(m.value(QLatin1StringView("one")), 1);
+    QVERIFY(!m.contains(QStringView(u"three")));
+    QVERIFY(m.remove(QLatin1StringView("one")));
+    QCOMPARE(m.size(), 1);
+
+    QFlatMap<QByteArray, int> b({ { "one"_ba, 1 } });
+    QCOMPARE(b.value(QByteArrayView("one")), 1);
+    QVERIFY(!b.contains(QByteArrayView("two")));
+}
+
 template <typename StringViewCompare>
 void tst_QFlatMap::transparency_impl()
 {
@@ -728,5 +766,60 @@ void tst_QFlatMap::varLengthArray()
     QVERIFY(m.isEmpty());
 }
 
+void tst_QFlatMap::flatSet()
+{
+    using Set = QFlatSet<int>;
+    Set empty;
+    QVERIFY(empty.isEmpty());
+    QVERIFY(empty.find(1) == empty.end());
+
+    Set s = { 5, 1, 3, 1, 4 };
+    QCOMPARE(s.size(), 4);
+    QCOMPARE(s.values(), QList<int>({ 1, 3, 4, 5 }));
+    QVERIFY(s.contains(3));
+    QVERIFY(!s.contains(2));
+    QCOMPARE(*s.lower_bound(2), 3);
+    QCOMPARE(*s.upper_bound(3), 4);
+
+    auto r = s.insert(2);
+    QVERIFY(r.second);
+    QCOMPARE(*r.first, 2);
+    r = s.insert(2);
+    QVERIFY(!r.second);
+    QCOMPARE(s.values(), QList<int>({ 1, 2, 3, 4, 5 }));
+
+    const std::vector<int> more = { 9, 0, 3, 7, 0 };
+    s.insert(more.begin(), more.end());
+    QCOMPARE(s.values(), QList<int>({ 0, 1, 2, 3, 4, 5, 7, 9 }));
+    const std::vector<int> sorted = { 6, 7, 8 };
+    s.insert(Qt::OrderedUniqueRange, sorted.begin(), sorted.end());
+    QCOMPARE(s.values(), QList<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    QVERIFY(s.remove(0));
+    QVERIFY(!s.remove(0));
+    QCOMPARE(s.remove_if(is_even), 4);
+    QCOMPARE(s.values(), QList<int>({ 1, 3, 5, 7, 9 }));
+    QCOMPARE(std::move(s).extract(), QList<int>({ 1, 3, 5, 7, 9 }));
+
+    Set ordered(Qt::OrderedUniqueRange, QList<int>({ 1, 2, 3 }));
+    QCOMPARE(ordered, Set({ 3, 2, 1 }));
+    QCOMPARE(std::distance(ordered.rbegin(), ordered.rend()), 3);
+    QCOMPARE(*ordered.rbegin(), 3);
+
+    // custom comparator
+    QFlatSet<int, std::greater<int>> descending({ 1, 3, 2 });
+    QCOMPARE(descending.values(), QList<int>({ 3, 2, 1 }));
+
+    // heterogeneous lookup
+    QFlatSet<QString> strings({ u"b"_s, u"a"_s });
+    QVERIFY(strings.contains(QStringView(u"a")));
+    QVERIFY(strings.contains(QLatin1StringView("b")));
+    QVERIFY(strings.find(QStringView(u"c")) == strings.end());
+    QVERIFY(strings.remove(QLatin1StringView("a")));
+
+    QVarLengthFlatSet<int, 16> vla({ 2, 1 });
+    QCOMPARE(*vla.begin(), 1);
+}
+
 QTEST_APPLESS_MAIN(tst_QFlatMap)
 #include "tst_qflatmap.moc"
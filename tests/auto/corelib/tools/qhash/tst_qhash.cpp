@@ -65,6 +65,8 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void clusteredHashFunction();
+    void heterogeneousSearch();
     void hashOfHash();
 
     void stdHash();
@@ -2466,6 +2468,121 @@ void tst_QHash::badHashFunction()
 
 }
 
+struct ClusteredKey {
+    int k;
+    ClusteredKey(int i) : k(i) {}
+    bool operator==(const ClusteredKey &other) const
+    {
+        return k == other.k;
+    }
+};
+
+// all keys go to the last buckets of the first span, so that the probe
+// sequences cross groups and wrap around, and their tags often collide
+size_t qHash(ClusteredKey key, size_t)
+{
+    return size_t(key.k % 4) + 120;
+}
+
+void tst_QHash::clusteredHashFunction()
+{
+    enum { Count = 60 };
+    QHash<ClusteredKey, int> hash;
+    for (int i = 0; i < Count; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), 64);
+
+    const auto check = [&hash](int i) {
+        if (i >= Count || i % 3 == 0)
+            return !hash.contains(i);
+        return hash.value(i, -1) == i;
+    };
+    for (int i = 0; i < Count; i += 3)
+        QVERIFY(hash.remove(i));
+    for (int i = 0; i < 2 * Count; ++i)
+        QVERIFY2(check(i), QByteArray::number(i));
+
+    // iteration still visits each entry once
+    QSet<int> seen;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+        QCOMPARE(it.key().k, it.value());
+        QVERIFY(!seen.contains(it.value()));
+        seen.insert(it.value());
+    }
+    QCOMPARE(seen.size(), hash.size());
+
+    for (int i = 0; i < Count; i += 3)
+        hash.insert(i, i);
+    for (int i = 0; i < Count; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+}
+
+void tst_QHash::heterogeneousSearch()
+{
+    const QString key = u"bar"_s;
+    const QByteArray latin1 = key.toLatin1();
+
+    QHash<QString, int> hash = { { u"foo"_s, 1 }, { key, 2 } };
+    QVERIFY(hash.contains(QStringView(key)));
+    QVERIFY(hash.contains(QLatin1StringView(latin1)));
+    QVERIFY(hash.contains(QUtf8StringView(latin1)));
+    QVERIFY(!hash.contains(QStringView(u"baz")));
+    QCOMPARE(hash.value(QStringView(key)), 2);
+    QCOMPARE(hash.value(QStringView(u"baz"), -1), -1);
+    QCOMPARE(hash.count(QLatin1StringView(latin1)), 1);
+    QCOMPARE(hash.constFind("foo"_L1).value(), 1);
+    QCOMPARE(hash.find(QUtf8StringView("baz")), hash.end());
+    QCOMPARE(std::as_const(hash).equal_range(QStringView(key)).first.key(), key);
+
+    // the non-const operator[] only creates a key when inserting
+    hash[QStringView(key)] = 3;
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(key), 3);
+    hash["baz"_L1] = 4;
+    QCOMPARE(hash.size(), 3);
+    QCOMPARE(hash.value(u"baz"_s), 4);
+    QCOMPARE(std::as_const(hash)[QStringView(QStringView(u"qux"))], 0);
+    QCOMPARE(hash.size(), 3);
+
+    // non-ASCII keys
+    const QString umlaut = QStringLiteral("gr\u00fc\u00dfe");
+    hash.insert(umlaut, 5);
+    QCOMPARE(hash.value(QLatin1StringView(umlaut.toLatin1())), 5);
+    QCOMPARE(hash.value(QUtf8StringView(umlaut.toUtf8())), 5);
+
+    QCOMPARE(hash.take(QStringView(umlaut)), 5);
+    QVERIFY(hash.remove("baz"_L1));
+    QVERIFY(!hash.remove("baz"_L1));
+    QCOMPARE(hash.keys().size(), 2);
+
+    // a shared hash detaches
+    QHash<QString, int> copy = hash;
+    copy[QStringView(QStringView(u"new"))] = 6;
+    QVERIFY(!hash.contains(QStringView(u"new")));
+    QVERIFY(copy.contains(QStringView(u"new")));
+
+    QHash<QByteArray, int> byteArrays = { { "foo"_ba, 1 } };
+    QCOMPARE(byteArrays.value(QByteArrayView("foo")), 1);
+    QVERIFY(!byteArrays.contains(QByteArrayView("bar")));
+    byteArrays[QByteArrayView("bar")] = 2;
+    QCOMPARE(byteArrays.value("bar"_ba), 2);
+
+    QMultiHash<QString, int> multi;
+    multi.insert(key, 1);
+    multi.insert(key, 2);
+    multi.insert(u"foo"_s, 3);
+    QCOMPARE(multi.count(QStringView(key)), 2);
+    QCOMPARE(multi.values(QLatin1StringView(latin1)).size(), 2);
+    QVERIFY(multi.contains(QUtf8StringView(latin1)));
+    QCOMPARE(multi.value("foo"_L1), 3);
+    const auto range = std::as_const(multi).equal_range(QStringView(key));
+    QCOMPARE(std::distance(range.first, range.second), 2);
+    multi[QStringView(QStringView(u"baz"))] = 4;
+    QCOMPARE(multi.value(u"baz"_s), 4);
+    QCOMPARE(multi.remove(QStringView(key)), 2);
+    QCOMPARE(multi.size(), 2);
+}
+
 void tst_QHash::hashOfHash()
 {
     QHash<int, int> hash;
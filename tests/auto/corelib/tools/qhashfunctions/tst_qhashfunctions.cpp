@@ -61,6 +61,18 @@ void tst_QHashFunctions::consistent()
     // QString-like
     const QString s = QStringLiteral("abcdefghijklmnopqrstuvxyz").repeated(16);
     QCOMPARE(qHash(s), qHash(QStringView(s)));
+    QCOMPARE(qHash(s), qHash(QLatin1StringView(s.toLatin1())));
+    QCOMPARE(qHash(s), qHash(QUtf8StringView(s.toUtf8())));
+    QCOMPARE(qHash(QString()), qHash(QLatin1StringView()));
+    QCOMPARE(qHash(QString()), qHash(QUtf8StringView()));
+
+    const QString latin1 = QStringLiteral("gr\u00fc\u00dfe");
+    QCOMPARE(qHash(latin1, 42), qHash(QLatin1StringView(latin1.toLatin1()), 42));
+    QCOMPARE(qHash(latin1, 42), qHash(QUtf8StringView(latin1.toUtf8()), 42));
+
+    // needs more than one UTF-16 code unit per code point
+    const QString nonBmp = QString::fromUcs4(U"\U0001F600 smile").repeated(50);
+    QCOMPARE(qHash(nonBmp), qHash(QUtf8StringView(nonBmp.toUtf8())));
 }
 
 void tst_QHashFunctions::initTestCase()
@@ -60,6 +60,7 @@ private slots:
     void eraseValidIteratorOnSharedMap();
     void removeElementsInMap();
     void toStdMap();
+    void heterogeneousSearch();
 };
 
 struct IdentityTracker {
@@ -2576,5 +2577,43 @@ void tst_QMap::toStdMap()
     toStdMapTestMethod<QMultiMap<int, QString>>(expectedMultiMap);
 }
 
+void tst_QMap::heterogeneousSearch()
+{
+    QMap<QString, int> map = { { QStringLiteral("a"), 1 }, { QStringLiteral("c"), 3 } };
+    QVERIFY(map.contains(QStringView(u"a")));
+    QVERIFY(map.contains(QLatin1StringView("c")));
+    QVERIFY(!map.contains(QStringView(u"b")));
+    QCOMPARE(map.value(QLatin1StringView("c")), 3);
+    QCOMPARE(map.value(QStringView(u"b"), -1), -1);
+    QCOMPARE(map.count(QStringView(u"a")), 1);
+    QCOMPARE(map.constFind(QLatin1StringView("a")).value(), 1);
+    QCOMPARE(map.find(QStringView(u"b")), map.end());
+    QCOMPARE(map.lowerBound(QStringView(u"b")).key(), QStringLiteral("c"));
+    QCOMPARE(std::as_const(map).upperBound(QLatin1StringView("a")).key(), QStringLiteral("c"));
+
+    // the non-const operator[] only creates a key when inserting
+    map[QStringView(u"a")] = 10;
+    QCOMPARE(map.size(), 2);
+    map[QLatin1StringView("b")] = 2;
+    QCOMPARE(map.keys(), QStringList({ "a", "b", "c" }));
+    QCOMPARE(map.value(QStringLiteral("a")), 10);
+
+    // a shared map detaches
+    QMap<QString, int> copy = map;
+    QCOMPARE(copy.remove(QStringView(u"b")), 1);
+    QCOMPARE(copy.remove(QStringView(u"b")), 0);
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(copy.size(), 2);
+    QCOMPARE(map.remove(QLatin1StringView("b")), 1);
+    QCOMPARE(map.take(QStringView(u"c")), 3);
+    QCOMPARE(map.keys(), QStringList({ "a" }));
+
+    QMap<QByteArray, int> byteArrays = { { QByteArray("foo"), 1 } };
+    QCOMPARE(byteArrays.value(QByteArrayView("foo")), 1);
+    QVERIFY(!byteArrays.contains(QByteArrayView("bar")));
+    byteArrays[QByteArrayView("bar")] = 2;
+    QCOMPARE(byteArrays.keys(), QByteArrayList({ "bar", "foo" }));
+}
+
 QTEST_APPLESS_MAIN(tst_QMap)
 #include "tst_qmap.moc"
@@ -46,6 +46,7 @@ private slots:
     void qhash();
     void intersects();
     void find();
+    void heterogeneousSearch();
     void values();
 };
 
@@ -1111,6 +1112,24 @@ void tst_QSet::find()
     QVERIFY(set.constFind(4) == set.constEnd());
 }
 
+void tst_QSet::heterogeneousSearch()
+{
+    QSet<QString> set = { QStringLiteral("foo"), QStringLiteral("bar") };
+    QVERIFY(set.contains(QStringView(u"foo")));
+    QVERIFY(set.contains(QLatin1StringView("bar")));
+    QVERIFY(set.contains(QUtf8StringView("bar")));
+    QVERIFY(!set.contains(QStringView(u"baz")));
+    QCOMPARE(*set.constFind(QLatin1StringView("foo")), QStringLiteral("foo"));
+    QCOMPARE(set.find(QStringView(u"baz")), set.end());
+    QVERIFY(set.remove(QLatin1StringView("foo")));
+    QVERIFY(!set.remove(QLatin1StringView("foo")));
+    QCOMPARE(set.size(), 1);
+
+    QSet<QByteArray> byteArrays = { QByteArray("foo") };
+    QVERIFY(byteArrays.contains(QByteArrayView("foo")));
+    QVERIFY(!byteArrays.contains(QByteArrayView("bar")));
+}
+
 template<typename T>
 QList<T> sorted(const QList<T> &list)
 {
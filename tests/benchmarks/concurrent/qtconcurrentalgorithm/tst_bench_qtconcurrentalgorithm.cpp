@@ -0,0 +1,118 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtConcurrent>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+#include <numeric>
+
+class tst_QtConcurrentAlgorithm : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sort_data();
+    void sort();
+    void stableSort_data() { sort_data(); }
+    void stableSort();
+    void inclusiveScan_data() { sort_data(); }
+    void inclusiveScan();
+    void partition_data() { sort_data(); }
+    void partition();
+};
+
+// a thread count of 0 measures the sequential standard algorithm
+void tst_QtConcurrentAlgorithm::sort_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("std") << 0;
+    for (int threads : { 1, 2, 4, 8, 16 })
+        QTest::addRow("threads=%d", threads) << threads;
+}
+
+static QList<int> randomList()
+{
+    QList<int> list(4000000);
+    QRandomGenerator generator(1);
+    for (int &i : list)
+        i = int(generator.generate());
+    return list;
+}
+
+void tst_QtConcurrentAlgorithm::sort()
+{
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threads, 1));
+    const QList<int> input = randomList();
+    QList<int> list;
+
+    QBENCHMARK {
+        list = input;
+        if (threads)
+            QtConcurrent::blockingSort(&pool, list);
+        else
+            std::sort(list.begin(), list.end());
+    }
+}
+
+void tst_QtConcurrentAlgorithm::stableSort()
+{
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threads, 1));
+    const QList<int> input = randomList();
+    QList<int> list;
+
+    QBENCHMARK {
+        list = input;
+        if (threads)
+            QtConcurrent::blockingStableSort(&pool, list);
+        else
+            std::stable_sort(list.begin(), list.end());
+    }
+}
+
+void tst_QtConcurrentAlgorithm::inclusiveScan()
+{
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threads, 1));
+    QList<quint32> list(16000000, 1);
+
+    QBENCHMARK {
+        if (threads)
+            QtConcurrent::blockingInclusiveScan(&pool, list);
+        else
+            std::inclusive_scan(list.begin(), list.end(), list.begin());
+    }
+}
+
+void tst_QtConcurrentAlgorithm::partition()
+{
+    QFETCH(int, threads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(threads, 1));
+    const QList<int> input = randomList();
+    QList<int> list;
+    const auto isEven = [](int i) { return (i & 1) == 0; };
+
+    QBENCHMARK {
+        list = input;
+        if (threads)
+            QtConcurrent::blockingPartition(&pool, list, isEven);
+        else
+            std::partition(list.begin(), list.end(), isEven);
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentAlgorithm)
+
+#include "tst_bench_qtconcurrentalgorithm.moc"
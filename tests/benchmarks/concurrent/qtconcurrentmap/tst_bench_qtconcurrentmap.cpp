@@ -0,0 +1,79 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtConcurrent>
+#include <QTest>
+
+#include <numeric>
+
+using namespace QtConcurrent;
+
+class tst_QtConcurrentMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void cheapFunction_data();
+    void cheapFunction();
+    void unevenFunction_data();
+    void unevenFunction();
+};
+
+static void addPolicies()
+{
+    QTest::addColumn<SchedulingPolicy>("policy");
+
+    QTest::newRow("adaptive") << SchedulingPolicy();
+    QTest::newRow("adaptive-grain-1024") << SchedulingPolicy(SchedulingPolicy::Adaptive, 1024);
+    QTest::newRow("guided") << SchedulingPolicy(SchedulingPolicy::Guided);
+    QTest::newRow("guided-grain-1024") << SchedulingPolicy(SchedulingPolicy::Guided, 1024);
+}
+
+void tst_QtConcurrentMap::cheapFunction_data()
+{
+    addPolicies();
+}
+
+// spends most of its time handing out the items, unless they are handed
+// out in large enough blocks
+void tst_QtConcurrentMap::cheapFunction()
+{
+    QFETCH(SchedulingPolicy, policy);
+
+    QList<int> list(1000000);
+    std::iota(list.begin(), list.end(), 0);
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(list, [](int &x) { x = x * 3 + 1; }, policy);
+    }
+}
+
+void tst_QtConcurrentMap::unevenFunction_data()
+{
+    addPolicies();
+}
+
+// the last items take much longer than the others, which leaves threads
+// idle at the end unless the blocks get smaller towards the end
+void tst_QtConcurrentMap::unevenFunction()
+{
+    QFETCH(SchedulingPolicy, policy);
+
+    QList<int> list(20000);
+    std::iota(list.begin(), list.end(), 0);
+    const int count = int(list.size());
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(list, [count](int &x) {
+            const int iterations = (x % count) < count * 9 / 10 ? 10 : 2000;
+            volatile int sink = x;
+            for (int i = 0; i < iterations; ++i)
+                sink = sink * 7 + i;
+            x = x % count;
+        }, policy);
+    }
+}
+
+QTEST_MAIN(tst_QtConcurrentMap)
+
+#include "tst_bench_qtconcurrentmap.moc"
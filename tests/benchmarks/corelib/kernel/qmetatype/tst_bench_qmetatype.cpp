@@ -3,6 +3,10 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+
+#include <memory>
+#include <vector>
 
 class tst_QMetaType : public QObject
 {
@@ -34,6 +38,9 @@ private slots:
     void isRegisteredCustom();
     void isRegisteredNotRegistered();
 
+    void lookupCustomMultiThreaded_data();
+    void lookupCustomMultiThreaded();
+
     void constructInPlace_data();
     void constructInPlace();
     void constructInPlaceCopy_data();
@@ -217,6 +224,45 @@ void tst_QMetaType::isRegisteredNotRegistered()
     }
 }
 
+void tst_QMetaType::lookupCustomMultiThreaded_data()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int threadCount : {1, 2, 4, 8})
+        QTest::addRow("%d", threadCount) << threadCount;
+}
+
+// QMetaType::fromName() and isRegistered() on custom types, called
+// concurrently from several threads
+void tst_QMetaType::lookupCustomMultiThreaded()
+{
+    QFETCH(int, threadCount);
+    const int type = qRegisterMetaType<Foo>("Foo");
+
+    class LookupThread : public QThread
+    {
+    public:
+        explicit LookupThread(int type) : type(type) {}
+        void run() override
+        {
+            for (int i = 0; i < 100000; ++i) {
+                QMetaType::fromName("Foo");
+                QMetaType::isRegistered(type);
+            }
+        }
+        const int type;
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<LookupThread>> threads;
+        for (int i = 0; i < threadCount; ++i)
+            threads.emplace_back(new LookupThread(type));
+        for (auto &thread : threads)
+            thread->start();
+        for (auto &thread : threads)
+            thread->wait();
+    }
+}
+
 void tst_QMetaType::constructInPlace_data()
 {
     QTest::addColumn<int>("typeId");
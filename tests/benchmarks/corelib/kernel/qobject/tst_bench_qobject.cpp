@@ -20,6 +20,10 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void signal_fan_out();
+    void signal_fan_out_data();
+    void signal_fan_out_with_churn();
+    void signal_fan_out_with_churn_data();
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
@@ -173,6 +177,80 @@ void tst_QObject::signal_many_receivers()
     }
 }
 
+enum class FanOutConnection { MemberFunction, StringBased, Functor };
+
+void tst_QObject::signal_fan_out_data()
+{
+    QTest::addColumn<int>("receiverCount");
+    QTest::addColumn<FanOutConnection>("connection");
+    for (int receiverCount : {1, 10, 50, 100, 500}) {
+        QTest::addRow("%d receivers, member function", receiverCount)
+                << receiverCount << FanOutConnection::MemberFunction;
+        QTest::addRow("%d receivers, string-based", receiverCount)
+                << receiverCount << FanOutConnection::StringBased;
+        QTest::addRow("%d receivers, functor", receiverCount)
+                << receiverCount << FanOutConnection::Functor;
+    }
+}
+
+static void connectFanOut(Object *sender, Object *receiver, FanOutConnection connection)
+{
+    switch (connection) {
+    case FanOutConnection::MemberFunction:
+        QObject::connect(sender, &Object::signal0, receiver, &Object::slot0);
+        break;
+    case FanOutConnection::StringBased:
+        QObject::connect(sender, SIGNAL(signal0()), receiver, SLOT(slot0()));
+        break;
+    case FanOutConnection::Functor:
+        QObject::connect(sender, &Object::signal0, receiver, Functor());
+        break;
+    }
+}
+
+void tst_QObject::signal_fan_out()
+{
+    QFETCH(int, receiverCount);
+    QFETCH(FanOutConnection, connection);
+    Object sender;
+    std::vector<Object> receivers(receiverCount);
+
+    for (Object &receiver : receivers)
+        connectFanOut(&sender, &receiver, connection);
+
+    QBENCHMARK {
+        sender.emitSignal0();
+    }
+}
+
+void tst_QObject::signal_fan_out_with_churn_data()
+{
+    QTest::addColumn<int>("receiverCount");
+    for (int receiverCount : {10, 50, 100, 500})
+        QTest::addRow("%d receivers", receiverCount) << receiverCount;
+}
+
+// one receiver is replaced between two emissions, so any state derived
+// from the list of connections must be updated every time
+void tst_QObject::signal_fan_out_with_churn()
+{
+    QFETCH(int, receiverCount);
+    Object sender;
+    std::vector<Object> receivers(receiverCount);
+
+    for (Object &receiver : receivers)
+        QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0);
+
+    Object extra;
+    QBENCHMARK {
+        QMetaObject::Connection c =
+                QObject::connect(&sender, &Object::signal0, &extra, &Object::slot0);
+        sender.emitSignal0();
+        QObject::disconnect(c);
+        sender.emitSignal0();
+    }
+}
+
 void tst_QObject::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
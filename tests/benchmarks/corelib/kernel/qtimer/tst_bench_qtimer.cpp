@@ -0,0 +1,109 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QTest>
+
+#include <vector>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void activeTimers_data();
+    void registerUnregister_data() { activeTimers_data(); }
+    void registerUnregister();
+    void restartTimer_data() { activeTimers_data(); }
+    void restartTimer();
+    void idleProcessEvents_data() { activeTimers_data(); }
+    void idleProcessEvents();
+
+private:
+    void startActiveTimers(int count);
+
+    std::vector<int> timerIds;
+    QObject receiver;
+};
+
+void tst_QTimer::init()
+{
+    QVERIFY(QAbstractEventDispatcher::instance());
+}
+
+void tst_QTimer::cleanup()
+{
+    QAbstractEventDispatcher::instance()->unregisterTimers(&receiver);
+    timerIds.clear();
+}
+
+void tst_QTimer::activeTimers_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100 timers") << 100;
+    QTest::newRow("1000 timers") << 1000;
+    QTest::newRow("10000 timers") << 10000;
+    QTest::newRow("100000 timers") << 100000;
+}
+
+void tst_QTimer::startActiveTimers(int count)
+{
+    // Spread the timeouts the way per-connection idle timeouts would be,
+    // none of them firing while the benchmark runs
+    auto dispatcher = QAbstractEventDispatcher::instance();
+    timerIds.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const qint64 interval = 60 * 1000 + (i * 7919) % (60 * 1000);
+        timerIds.push_back(dispatcher->registerTimer(interval, Qt::CoarseTimer, &receiver));
+    }
+}
+
+void tst_QTimer::registerUnregister()
+{
+    QFETCH(int, count);
+    startActiveTimers(count);
+
+    auto dispatcher = QAbstractEventDispatcher::instance();
+    const int timerId = timerIds.back();
+    QVERIFY(dispatcher->unregisterTimer(timerId));
+
+    QBENCHMARK {
+        dispatcher->registerTimer(timerId, 90 * 1000, Qt::CoarseTimer, &receiver);
+        dispatcher->unregisterTimer(timerId);
+    }
+}
+
+void tst_QTimer::restartTimer()
+{
+    QFETCH(int, count);
+    startActiveTimers(count);
+
+    // what QTimer::start() does on an active timer, e.g. on every read on a
+    // socket with an idle timeout
+    auto dispatcher = QAbstractEventDispatcher::instance();
+    size_t i = 0;
+    QBENCHMARK {
+        const int timerId = timerIds[i];
+        dispatcher->unregisterTimer(timerId);
+        dispatcher->registerTimer(timerId, 60 * 1000, Qt::CoarseTimer, &receiver);
+        if (++i == timerIds.size())
+            i = 0;
+    }
+}
+
+void tst_QTimer::idleProcessEvents()
+{
+    QFETCH(int, count);
+    startActiveTimers(count);
+
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
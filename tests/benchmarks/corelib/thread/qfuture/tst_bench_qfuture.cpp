@@ -23,6 +23,8 @@ private slots:
     void reportResult();
     void reportResults();
     void reportResultsManualProgress();
+    void reportSmallResults();
+    void contiguousResultsAt();
 #ifndef QT_NO_EXCEPTIONS
     void reportException();
 #endif
@@ -127,6 +129,38 @@ void tst_QFuture::reportResultsManualProgress()
     }
 }
 
+void tst_QFuture::reportSmallResults()
+{
+    QFutureInterface<int> fi;
+    const QList<int> values { 0, 1, 2, 3 };
+    QBENCHMARK {
+        for (int i = 0; i < 250; ++i)
+            fi.reportResults(values);
+    }
+}
+
+void tst_QFuture::contiguousResultsAt()
+{
+    QFutureInterface<int> fi;
+    fi.reportStarted();
+    for (int i = 0; i < 100000; ++i)
+        fi.reportResult(i);
+    fi.reportFinished();
+    const QFuture<int> future = fi.future();
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (int index = 0; index < future.resultCount();) {
+            int count = 0;
+            const int *results = future.contiguousResultsAt(index, &count);
+            for (int i = 0; i < count; ++i)
+                sum += results[i];
+            index += count;
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
 #ifndef QT_NO_EXCEPTIONS
 void tst_QFuture::reportException()
 {
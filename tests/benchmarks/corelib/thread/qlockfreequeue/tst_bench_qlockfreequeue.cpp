@@ -0,0 +1,171 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <qlockfreequeue.h>
+#include <qmutex.h>
+#include <qqueue.h>
+#include <qthread.h>
+#include <qwaitcondition.h>
+
+#include <memory>
+
+enum { Count = 1000000, Capacity = 1024, BatchSize = 64 };
+
+// what everyone writes when there is no queue at hand
+class LockedQueue
+{
+public:
+    void push(int value)
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.size() == Capacity)
+            notFull.wait(&mutex);
+        queue.enqueue(value);
+        notEmpty.wakeOne();
+    }
+
+    int pop()
+    {
+        QMutexLocker locker(&mutex);
+        while (queue.isEmpty())
+            notEmpty.wait(&mutex);
+        const int value = queue.dequeue();
+        notFull.wakeOne();
+        return value;
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    QQueue<int> queue;
+};
+
+class tst_QLockFreeQueue : public QObject
+{
+    Q_OBJECT
+private slots:
+    void producerConsumer_data();
+    void producerConsumer();
+};
+
+template <typename Queue>
+static void pushAll(Queue &queue)
+{
+    for (int i = 0; i < Count; ++i)
+        queue.push(i);
+}
+
+template <typename Queue>
+static void pushAllInBatches(Queue &queue)
+{
+    int values[BatchSize];
+    for (int i = 0; i < Count;) {
+        const int n = qMin(int(BatchSize), Count - i);
+        for (int j = 0; j < n; ++j)
+            values[j] = i + j;
+        const qsizetype pushed = queue.tryPush(values, values + n);
+        if (!pushed)
+            queue.push(values[0]);
+        i += qMax(int(pushed), 1);
+    }
+}
+
+template <typename Queue>
+static qint64 popAll(Queue &queue)
+{
+    qint64 sum = 0;
+    for (int i = 0; i < Count; ++i) {
+        int value;
+        queue.pop(&value);
+        sum += value;
+    }
+    return sum;
+}
+
+template <typename Queue>
+static qint64 popAllInBatches(Queue &queue)
+{
+    qint64 sum = 0;
+    int values[BatchSize];
+    for (int i = 0; i < Count;) {
+        qsizetype n = queue.tryPop(values, BatchSize);
+        if (!n)
+            n = queue.pop(values) ? 1 : 0;
+        for (qsizetype j = 0; j < n; ++j)
+            sum += values[j];
+        i += int(n);
+    }
+    return sum;
+}
+
+enum Variant { Locked, Spsc, SpscBatches, Mpmc, MpmcBatches };
+Q_DECLARE_METATYPE(Variant)
+
+template <typename Queue, typename Push, typename Pop>
+static void run(Push push, Pop pop)
+{
+    QBENCHMARK {
+        auto queue = std::make_unique<Queue>();
+        std::unique_ptr<QThread> producer(QThread::create([&] { push(*queue); }));
+        producer->start();
+        const qint64 sum = pop(*queue);
+        producer->wait();
+        QCOMPARE(sum, qint64(Count) * (Count - 1) / 2);
+    }
+}
+
+template <typename T>
+struct Sized : T
+{
+    Sized() : T(Capacity) {}
+};
+
+void tst_QLockFreeQueue::producerConsumer_data()
+{
+    QTest::addColumn<Variant>("variant");
+
+    QTest::newRow("QMutex+QQueue+QWaitCondition") << Locked;
+    QTest::newRow("QSpscQueue") << Spsc;
+    QTest::newRow("QSpscQueue, batches") << SpscBatches;
+    QTest::newRow("QMpmcQueue") << Mpmc;
+    QTest::newRow("QMpmcQueue, batches") << MpmcBatches;
+}
+
+void tst_QLockFreeQueue::producerConsumer()
+{
+    QFETCH(Variant, variant);
+
+    using SpscQueue = Sized<QSpscQueue<int>>;
+    using MpmcQueue = Sized<QMpmcQueue<int>>;
+    switch (variant) {
+    case Locked:
+        run<LockedQueue>([](LockedQueue &queue) {
+            for (int i = 0; i < Count; ++i)
+                queue.push(i);
+        }, [](LockedQueue &queue) {
+            qint64 sum = 0;
+            for (int i = 0; i < Count; ++i)
+                sum += queue.pop();
+            return sum;
+        });
+        break;
+    case Spsc:
+        run<SpscQueue>(pushAll<SpscQueue>, popAll<SpscQueue>);
+        break;
+    case SpscBatches:
+        run<SpscQueue>(pushAllInBatches<SpscQueue>, popAllInBatches<SpscQueue>);
+        break;
+    case Mpmc:
+        run<MpmcQueue>(pushAll<MpmcQueue>, popAll<MpmcQueue>);
+        break;
+    case MpmcBatches:
+        run<MpmcQueue>(pushAllInBatches<MpmcQueue>, popAllInBatches<MpmcQueue>);
+        break;
+    }
+}
+
+QTEST_MAIN(tst_QLockFreeQueue)
+#include "tst_bench_qlockfreequeue.moc"
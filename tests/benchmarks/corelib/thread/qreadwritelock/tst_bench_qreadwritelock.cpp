@@ -82,7 +82,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
-    // void readWrite();
+    void readMostly_data();
+    void readMostly();
 };
 
 struct FunctionPtrHolder
@@ -294,5 +295,67 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadMostly()
+{
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        void run() override
+        {
+            for (int i = 0; i < Iterations; ++i) {
+                QString s = QString::number(i); // Do something outside the lock
+                if (i % 16 == 0) {
+                    WriteLocker locker(lock);
+                    global_hash.insert(s, s);
+                } else {
+                    ReadLocker locker(lock);
+                    global_hash.contains(s);
+                }
+            }
+        }
+    };
+    Mutex lock;
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = std::make_unique<Thread>();
+        t->lock = &lock;
+        threads.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : threads) {
+            t->start();
+        }
+        for (auto &t : threads) {
+            t->wait();
+        }
+    }
+    global_hash.clear();
+}
+
+void tst_QReadWriteLock::readMostly_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+
+    QTest::newRow("QMutex") << FunctionPtrHolder(
+        testReadMostly<QMutex, QMutexLocker<QMutex>, QMutexLocker<QMutex>>);
+    QTest::newRow("QReadWriteLock") << FunctionPtrHolder(
+        testReadMostly<QReadWriteLock, QReadLocker, QWriteLocker>);
+    QTest::newRow("QReadWriteLock, recursive") << FunctionPtrHolder(
+        testReadMostly<QRecursiveReadWriteLock, QReadLocker, QWriteLocker>);
+#ifdef __cpp_lib_shared_mutex
+    QTest::newRow("std::shared_mutex") << FunctionPtrHolder(
+        testReadMostly<std::shared_mutex,
+                       LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                       LockerWrapper<std::unique_lock<std::shared_mutex>>>);
+#endif
+}
+
+void tst_QReadWriteLock::readMostly()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    holder.value();
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
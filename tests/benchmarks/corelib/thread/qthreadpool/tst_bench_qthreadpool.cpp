@@ -15,6 +15,10 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void startFromPoolThreads_data();
+    void startFromPoolThreads();
+    void recursiveSplit_data() { startFromPoolThreads_data(); }
+    void recursiveSplit();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +54,58 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::startFromPoolThreads_data()
+{
+    QTest::addColumn<int>("threadCount");
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int n = 1; n < idealThreadCount; n *= 2)
+        QTest::addRow("%d", n) << n;
+    QTest::addRow("%d", idealThreadCount) << idealThreadCount;
+}
+
+void tst_QThreadPool::startFromPoolThreads()
+{
+    QFETCH(int, threadCount);
+    constexpr int TasksPerThread = 10000;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QSemaphore done;
+    QBENCHMARK {
+        for (int i = 0; i < threadCount; ++i) {
+            threadPool.start([&] {
+                for (int j = 0; j < TasksPerThread; ++j)
+                    threadPool.start([&done] { done.release(); });
+            });
+        }
+        done.acquire(threadCount * TasksPerThread);
+    }
+}
+
+static void split(QThreadPool *threadPool, QSemaphore *done, int depth)
+{
+    if (!depth) {
+        done->release();
+        return;
+    }
+    threadPool->start([=] { split(threadPool, done, depth - 1); });
+    threadPool->start([=] { split(threadPool, done, depth - 1); });
+}
+
+void tst_QThreadPool::recursiveSplit()
+{
+    QFETCH(int, threadCount);
+    constexpr int Depth = 14;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QSemaphore done;
+    QBENCHMARK {
+        threadPool.start([&] { split(&threadPool, &done, Depth); });
+        done.acquire(1 << Depth);
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
@@ -3,19 +3,51 @@
 #include <QString>
 #include <QMap>
 #include <QHash>
+#include <QFlatMap>
 
 #include <qtest.h>
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
 class tst_associative_containers : public QObject
 {
     Q_OBJECT
+public:
+    enum Container { Hash, Map, FlatMap };
+    Q_ENUM(Container)
+
 private slots:
-    void insert_data();
+    void insert_data() { containers_data(); }
     void insert();
-    void lookup_data();
+    void lookup_data() { containers_data(); }
     void lookup();
+    void lookup_string_data() { containers_data(); }
+    void lookup_string();
+    void build_data() { containers_data(); }
+    void build();
+
+private:
+    void containers_data();
 };
 
+void tst_associative_containers::containers_data()
+{
+    QTest::addColumn<Container>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size = 10; size < 20000; size += 100) {
+
+        const QByteArray sizeString = QByteArray::number(size);
+
+        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << Hash << size;
+        QTest::newRow(QByteArray("map--" + sizeString).constData()) << Map << size;
+        QTest::newRow(QByteArray("flatmap--" + sizeString).constData()) << FlatMap << size;
+    }
+}
+
 template <typename T>
 void testInsert(int size)
 {
@@ -27,79 +59,117 @@ void testInsert(int size)
     }
 }
 
-void tst_associative_containers::insert_data()
-{
-    QTest::addColumn<bool>("useHash");
-    QTest::addColumn<int>("size");
-
-    for (int size = 10; size < 20000; size += 100) {
-
-        const QByteArray sizeString = QByteArray::number(size);
-
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
-    }
-}
-
 void tst_associative_containers::insert()
 {
-    QFETCH(bool, useHash);
+    QFETCH(Container, container);
     QFETCH(int, size);
 
-    QHash<int, int> testHash;
-    QMap<int, int> testMap;
-
-    if (useHash) {
+    switch (container) {
+    case Hash:
         testInsert<QHash<int, int> >(size);
-    } else {
+        break;
+    case Map:
         testInsert<QMap<int, int> >(size);
+        break;
+    case FlatMap:
+        testInsert<QFlatMap<int, int> >(size);
+        break;
     }
 }
 
-void tst_associative_containers::lookup_data()
+template <typename T, typename Key>
+void testLookup(const QList<Key> &keys)
 {
-//    setReportType(LineChartReport);
-//    setChartTitle("Time to call value(), with an increasing number of items in the container");
-
-    QTest::addColumn<bool>("useHash");
-    QTest::addColumn<int>("size");
+    T container;
 
-    for (int size = 10; size < 20000; size += 100) {
+    for (qsizetype i = 0; i < keys.size(); ++i)
+        container.insert(keys.at(i), int(i));
 
-        const QByteArray sizeString = QByteArray::number(size);
+    qint64 sum = 0;
 
-        QTest::newRow(QByteArray("hash--" + sizeString).constData()) << true << size;
-        QTest::newRow(QByteArray("map--" + sizeString).constData()) << false << size;
+    QBENCHMARK {
+        for (const Key &key : keys)
+            sum += container.value(key);
     }
+    // use the result, so that the lookups aren't optimized away
+    QVERIFY(sum >= 0);
 }
 
-template <typename T>
-void testLookup(int size)
+template <typename Key>
+void testLookup(tst_associative_containers::Container container, const QList<Key> &keys)
 {
-    T container;
+    switch (container) {
+    case tst_associative_containers::Hash:
+        testLookup<QHash<Key, int> >(keys);
+        break;
+    case tst_associative_containers::Map:
+        testLookup<QMap<Key, int> >(keys);
+        break;
+    case tst_associative_containers::FlatMap:
+        testLookup<QFlatMap<Key, int> >(keys);
+        break;
+    }
+}
 
-    for (int i = 0; i < size; ++i)
-        container.insert(i, i);
+void tst_associative_containers::lookup()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
 
-    int val;
+    QList<int> keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    testLookup(container, keys);
+}
 
-    QBENCHMARK {
-        for (int i = 0; i < size; ++i)
-            val = container.value(i);
+void tst_associative_containers::lookup_string()
+{
+    QFETCH(Container, container);
+    QFETCH(int, size);
 
-    }
-    Q_UNUSED(val);
+    QList<QString> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(QString::number(i * 7919));
+    // look the keys up in a different order than they were inserted
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(size));
+    testLookup(container, keys);
 }
 
-void tst_associative_containers::lookup()
+void tst_associative_containers::build()
 {
-    QFETCH(bool, useHash);
+    QFETCH(Container, container);
     QFETCH(int, size);
 
-    if (useHash) {
-        testLookup<QHash<int, int> >(size);
-    } else {
-        testLookup<QMap<int, int> >(size);
+    // the time to build a container from unsorted items
+    std::vector<std::pair<int, int>> items(size);
+    for (int i = 0; i < size; ++i)
+        items[i] = { i, i };
+    std::shuffle(items.begin(), items.end(), std::mt19937(size));
+
+    switch (container) {
+    case Hash:
+        QBENCHMARK {
+            QHash<int, int> hash;
+            hash.reserve(size);
+            for (const auto &item : items)
+                hash.insert(item.first, item.second);
+        }
+        break;
+    case Map:
+        QBENCHMARK {
+            QMap<int, int> map;
+            for (const auto &item : items)
+                map.insert(item.first, item.second);
+        }
+        break;
+    case FlatMap: {
+        using Flat = QFlatMap<int, int>;
+        std::vector<Flat::value_type> values(items.begin(), items.end());
+        QBENCHMARK {
+            Flat map(values.begin(), values.end());
+        }
+        break;
+    }
     }
 }
 
@@ -11,6 +11,9 @@
 #include <QUuid>
 #include <QTest>
 
+#include <algorithm>
+#include <random>
+
 
 class tst_QHash : public QObject
 {
@@ -36,10 +39,17 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_int_data() { lookupData(1 << 20); }
+    void lookup_int() { lookup_template<int>(); }
+    void lookup_string_data() { lookupData(1 << 16); }
+    void lookup_string() { lookup_template<QString>(); }
+
 private:
     void data();
+    void lookupData(int maxSize);
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Key> void lookup_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -144,6 +154,56 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::lookupData(int maxSize)
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("hitPercent");
+
+    for (int size = 64; size <= maxSize; size *= 16) {
+        for (int hitPercent : { 100, 90, 50, 0 })
+            QTest::addRow("size=%d,hits=%d%%", size, hitPercent) << size << hitPercent;
+    }
+}
+
+template <typename Key> static Key lookupKey(int i)
+{
+    if constexpr (std::is_same_v<Key, QString>)
+        return QString::number(i);
+    else
+        return Key(i);
+}
+
+template <typename Key> void tst_QHash::lookup_template()
+{
+    // looks up as many keys as there are in the hash, of which hitPercent are
+    // in it; the others are the keys that follow them, which aren't
+    QFETCH(int, size);
+    QFETCH(int, hitPercent);
+
+    QHash<Key, int> hash;
+    hash.reserve(size);
+    for (int i = 0; i < size; ++i)
+        hash.insert(lookupKey<Key>(i), i);
+
+    QList<Key> keys;
+    keys.reserve(size);
+    qsizetype hits = 0;
+    for (int i = 0; i < size; ++i) {
+        const bool hit = i * 100 < hitPercent * size;
+        keys.append(lookupKey<Key>(hit ? i : size + i));
+        hits += hit;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(size));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const Key &key : std::as_const(keys))
+            found += hash.contains(key);
+    }
+    QCOMPARE(found, hits);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"